@@ -0,0 +1,434 @@
+#include "collection_snapshot.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <utility>
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <limits.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define EROHIN_SNAPSHOT_SUPPORTED
+#endif
+
+// Layout, native byte order:
+//   char[8] magic, uint32 byte order mark, uint32 reserved
+//   uint64 source size, uint64 FNV-1a hash of the source bytes
+//   uint64 dictionary count, uint64 offset of every dictionary block
+// Each block, dictionaries in name order:
+//   uint32 name size, name, uint64 record count
+//   records in key order: varint key, varint value size, value
+// Varints are LEB128: seven bits per byte, low bits first.
+// Snapshots live in $EROHIN_SNAPSHOT_DIR, one file per source, named after
+// a hash of the source's absolute path. Without that variable they are off.
+
+#ifdef EROHIN_SNAPSHOT_SUPPORTED
+namespace
+{
+  const char snapshot_magic[8] = { 'E', 'R', 'S', 'N', 'A', 'P', '0', '1' };
+  const uint32_t byte_order_mark = 0x01020304;
+
+  struct SourceStamp
+  {
+    uint64_t size;
+    uint64_t hash;
+  };
+
+  struct Header
+  {
+    char magic[8];
+    uint32_t byte_order;
+    uint32_t reserved;
+    SourceStamp stamp;
+    uint64_t dict_count;
+  };
+
+  uint64_t getHash(const char * data, size_t size)
+  {
+    uint64_t hash = 0xcbf29ce484222325ull;
+    for (size_t i = 0; i < size; ++i)
+    {
+      hash ^= static_cast< unsigned char >(data[i]);
+      hash *= 0x100000001b3ull;
+    }
+    return hash;
+  }
+
+  bool getSnapshotName(const std::string & source_name, std::string & snapshot_name)
+  {
+    const char * dir = std::getenv("EROHIN_SNAPSHOT_DIR");
+    if (!dir || !*dir)
+    {
+      return false;
+    }
+    char path[PATH_MAX];
+    if (!realpath(source_name.c_str(), path))
+    {
+      return false;
+    }
+    char name[17];
+    unsigned long long path_hash = getHash(path, std::strlen(path));
+    std::snprintf(name, sizeof(name), "%016llx", path_hash);
+    snapshot_name = std::string(dir) + "/" + name + ".snap";
+    return true;
+  }
+
+  class MappedFile
+  {
+  public:
+    explicit MappedFile(const std::string & name):
+      data_(nullptr),
+      size_(0)
+    {
+      int fd = open(name.c_str(), O_RDONLY);
+      if (fd < 0)
+      {
+        return;
+      }
+      struct stat info;
+      if (fstat(fd, std::addressof(info)) == 0 && info.st_size > 0)
+      {
+        void * data = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data != MAP_FAILED)
+        {
+          data_ = static_cast< const char * >(data);
+          size_ = info.st_size;
+        }
+      }
+      close(fd);
+    }
+    MappedFile(const MappedFile &) = delete;
+    MappedFile & operator=(const MappedFile &) = delete;
+    ~MappedFile()
+    {
+      if (data_)
+      {
+        munmap(const_cast< char * >(data_), size_);
+      }
+    }
+    const char * data() const noexcept
+    {
+      return data_;
+    }
+    size_t size() const noexcept
+    {
+      return size_;
+    }
+  private:
+    const char * data_;
+    size_t size_;
+  };
+
+  // The stamp covers the source bytes themselves: an in-place rewrite of
+  // the same size within the same second still changes it.
+  bool getStamp(const std::string & source_name, SourceStamp & stamp)
+  {
+    struct stat info;
+    if (stat(source_name.c_str(), std::addressof(info)) != 0)
+    {
+      return false;
+    }
+    MappedFile file(source_name);
+    if (info.st_size > 0 && !file.data())
+    {
+      return false;
+    }
+    stamp.size = file.size();
+    stamp.hash = getHash(file.data(), file.size());
+    return true;
+  }
+
+  template< class T >
+  T readRaw(const char * pos)
+  {
+    T value;
+    std::memcpy(std::addressof(value), pos, sizeof(T));
+    return value;
+  }
+
+  // Bounds-checked walk over a mapped block; the cursor becomes null on the
+  // first read past the end.
+  struct Cursor
+  {
+    const char * pos;
+    const char * end;
+
+    template< class T >
+    T read()
+    {
+      if (!pos || static_cast< size_t >(end - pos) < sizeof(T))
+      {
+        pos = nullptr;
+        return T();
+      }
+      T value = readRaw< T >(pos);
+      pos += sizeof(T);
+      return value;
+    }
+
+    uint64_t readVarint()
+    {
+      uint64_t value = 0;
+      for (unsigned shift = 0; pos && shift < 64; shift += 7)
+      {
+        unsigned char byte = read< unsigned char >();
+        value |= static_cast< uint64_t >(byte & 0x7F) << shift;
+        if (!(byte & 0x80))
+        {
+          return value;
+        }
+      }
+      pos = nullptr;
+      return 0;
+    }
+
+    const char * skip(size_t count)
+    {
+      if (!pos || static_cast< size_t >(end - pos) < count)
+      {
+        pos = nullptr;
+        return nullptr;
+      }
+      const char * start = pos;
+      pos += count;
+      return start;
+    }
+  };
+
+  // Converts to std::string only when a tree node is built from it, so
+  // the sortedness check of the bulk insert reads keys without copying.
+  struct MappedString
+  {
+    const char * data;
+    uint32_t size;
+
+    operator std::string() const
+    {
+      return std::string(data, size);
+    }
+  };
+
+  // Records are validated by a Cursor pass before iteration starts, so the
+  // iterator decodes each record once, on arrival, and never overruns.
+  class RecordIterator
+  {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = std::pair< size_t, MappedString >;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const value_type *;
+    using reference = value_type;
+
+    RecordIterator(const char * pos, const char * end, size_t index, size_t count):
+      cursor_{ pos, end },
+      index_(index),
+      count_(count),
+      current_(0, MappedString{ nullptr, 0 })
+    {
+      decode();
+    }
+    value_type operator*() const
+    {
+      return current_;
+    }
+    RecordIterator & operator++()
+    {
+      ++index_;
+      decode();
+      return *this;
+    }
+    RecordIterator operator++(int)
+    {
+      RecordIterator result(*this);
+      ++(*this);
+      return result;
+    }
+    bool operator==(const RecordIterator & rhs) const
+    {
+      return index_ == rhs.index_;
+    }
+    bool operator!=(const RecordIterator & rhs) const
+    {
+      return !(*this == rhs);
+    }
+  private:
+    Cursor cursor_;
+    size_t index_;
+    size_t count_;
+    value_type current_;
+
+    void decode()
+    {
+      if (index_ < count_)
+      {
+        current_.first = cursor_.readVarint();
+        current_.second.size = cursor_.readVarint();
+        current_.second.data = cursor_.skip(current_.second.size);
+      }
+    }
+  };
+
+  bool readDictionary(Cursor cursor, std::string & name, erohin::dictionary & dict)
+  {
+    uint32_t name_size = cursor.read< uint32_t >();
+    const char * name_data = cursor.skip(name_size);
+    uint64_t record_count = cursor.read< uint64_t >();
+    const char * records = cursor.pos;
+    for (uint64_t i = 0; cursor.pos && i < record_count; ++i)
+    {
+      cursor.readVarint();
+      uint64_t value_size = cursor.readVarint();
+      if (value_size > std::numeric_limits< uint32_t >::max())
+      {
+        return false;
+      }
+      cursor.skip(value_size);
+    }
+    if (!cursor.pos)
+    {
+      return false;
+    }
+    name.assign(name_data, name_size);
+    dict.insert(RecordIterator(records, cursor.pos, 0, record_count), RecordIterator(nullptr, nullptr, record_count, record_count));
+    return dict.size() == record_count;
+  }
+
+  template< class T >
+  void writeRaw(std::ostream & output, const T & value)
+  {
+    output.write(reinterpret_cast< const char * >(std::addressof(value)), sizeof(T));
+  }
+
+  size_t getVarintSize(uint64_t value)
+  {
+    size_t size = 1;
+    while (value >= 0x80)
+    {
+      value >>= 7;
+      ++size;
+    }
+    return size;
+  }
+
+  void writeVarint(std::ostream & output, uint64_t value)
+  {
+    while (value >= 0x80)
+    {
+      output.put(static_cast< char >((value & 0x7F) | 0x80));
+      value >>= 7;
+    }
+    output.put(static_cast< char >(value));
+  }
+
+  uint64_t getBlockSize(const std::string & name, const erohin::dictionary & dict)
+  {
+    uint64_t size = sizeof(uint32_t) + name.size() + sizeof(uint64_t);
+    for (auto iter = dict.cbegin(); iter != dict.cend(); ++iter)
+    {
+      size += getVarintSize(iter->first) + getVarintSize(iter->second.size()) + iter->second.size();
+    }
+    return size;
+  }
+}
+
+bool erohin::loadSnapshot(const std::string & source_name, collection & dest)
+{
+  std::string snapshot_name;
+  SourceStamp stamp;
+  if (!getSnapshotName(source_name, snapshot_name) || !getStamp(source_name, stamp))
+  {
+    return false;
+  }
+  MappedFile file(snapshot_name);
+  Cursor cursor{ file.data(), file.data() + file.size() };
+  Header header = cursor.read< Header >();
+  if (!cursor.pos || std::memcmp(header.magic, snapshot_magic, sizeof(snapshot_magic)) != 0
+    || header.byte_order != byte_order_mark || header.stamp.size != stamp.size
+    || header.stamp.hash != stamp.hash)
+  {
+    return false;
+  }
+  collection result;
+  for (uint64_t i = 0; i < header.dict_count; ++i)
+  {
+    uint64_t offset = cursor.read< uint64_t >();
+    if (!cursor.pos || offset > file.size())
+    {
+      return false;
+    }
+    std::string name;
+    dictionary dict;
+    if (!readDictionary(Cursor{ file.data() + offset, file.data() + file.size() }, name, dict))
+    {
+      return false;
+    }
+    result.insert(std::make_pair(std::move(name), std::move(dict)));
+  }
+  if (result.size() != header.dict_count)
+  {
+    return false;
+  }
+  dest.swap(result);
+  return true;
+}
+
+void erohin::saveSnapshot(const std::string & source_name, const collection & source)
+{
+  Header header = {};
+  std::memcpy(header.magic, snapshot_magic, sizeof(snapshot_magic));
+  header.byte_order = byte_order_mark;
+  std::string snapshot_name;
+  if (!getSnapshotName(source_name, snapshot_name) || !getStamp(source_name, header.stamp))
+  {
+    return;
+  }
+  header.dict_count = source.size();
+  std::string temp_name = snapshot_name + ".tmp";
+  {
+    std::ofstream output(temp_name, std::ios::binary | std::ios::trunc);
+    writeRaw(output, header);
+    uint64_t offset = sizeof(Header) + header.dict_count * sizeof(uint64_t);
+    for (auto iter = source.cbegin(); iter != source.cend(); ++iter)
+    {
+      writeRaw(output, offset);
+      offset += getBlockSize(iter->first, iter->second);
+    }
+    for (auto iter = source.cbegin(); iter != source.cend(); ++iter)
+    {
+      writeRaw(output, static_cast< uint32_t >(iter->first.size()));
+      output.write(iter->first.data(), iter->first.size());
+      writeRaw(output, static_cast< uint64_t >(iter->second.size()));
+      for (auto dict_iter = iter->second.cbegin(); dict_iter != iter->second.cend(); ++dict_iter)
+      {
+        writeVarint(output, dict_iter->first);
+        writeVarint(output, dict_iter->second.size());
+        output.write(dict_iter->second.data(), dict_iter->second.size());
+      }
+    }
+    if (!output.flush())
+    {
+      output.close();
+      std::remove(temp_name.c_str());
+      return;
+    }
+  }
+  if (std::rename(temp_name.c_str(), snapshot_name.c_str()) != 0)
+  {
+    std::remove(temp_name.c_str());
+  }
+}
+#else
+bool erohin::loadSnapshot(const std::string &, collection &)
+{
+  return false;
+}
+
+void erohin::saveSnapshot(const std::string &, const collection &)
+{}
+#endif
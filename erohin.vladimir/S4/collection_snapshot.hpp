@@ -0,0 +1,16 @@
+#ifndef COLLECTION_SNAPSHOT_HPP
+#define COLLECTION_SNAPSHOT_HPP
+
+#include <string>
+#include "input_output_collection.hpp"
+
+namespace erohin
+{
+  // Binary image of a parsed dataset, cached in $EROHIN_SNAPSHOT_DIR when
+  // that variable is set; otherwise both calls do nothing. It is tied to the
+  // size and a hash of the source bytes, so any edit makes it stale.
+  bool loadSnapshot(const std::string & source_name, collection & dest);
+  void saveSnapshot(const std::string & source_name, const collection & source);
+}
+
+#endif
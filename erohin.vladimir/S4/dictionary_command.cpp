@@ -2,6 +2,26 @@
 #include <iostream>
 #include <cstring>
 
+namespace
+{
+  // Inserting a new name thaws the collection, and the result of a set
+  // operation is never frozen, so both are frozen again here.
+  void storeResult(erohin::collection & context, const std::string & name, erohin::dictionary && result)
+  {
+    result.freeze();
+    auto iter = context.find(name);
+    if (iter != context.end())
+    {
+      iter->second = std::move(result);
+    }
+    else
+    {
+      context.insert(std::make_pair(name, std::move(result)));
+      context.freeze();
+    }
+  }
+}
+
 void erohin::print(const collection & context, std::istream & input, std::ostream & output)
 {
   std::string dict_name;
@@ -26,74 +46,31 @@ void erohin::complement(collection & context, std::istream & input, std::ostream
 {
   std::string dict_name[3];
   input >> dict_name[0] >> dict_name[1] >> dict_name[2];
-  dictionary temp_dict;
   const dictionary & source1 = context.at(dict_name[1]);
   const dictionary & source2 = context.at(dict_name[2]);
-  auto iter = source1.cbegin();
-  auto end_iter = source1.cend();
-  while (iter != end_iter)
-  {
-    if (source2.find(iter->first) == source2.cend())
-    {
-      temp_dict.insert(*iter);
-    }
-    ++iter;
-  }
-  if (context.find(dict_name[0]) != context.end())
-  {
-    context.at(dict_name[0]).clear();
-    context.at(dict_name[0]) = std::move(temp_dict);
-  }
-  else
-  {
-    context.insert(std::make_pair(dict_name[0], std::move(temp_dict)));
-  }
+  dictionary temp_dict(source1);
+  temp_dict.set_difference(source2);
+  storeResult(context, dict_name[0], std::move(temp_dict));
 }
 
 void erohin::intersect(collection & context, std::istream & input, std::ostream &)
 {
   std::string dict_name[3];
   input >> dict_name[0] >> dict_name[1] >> dict_name[2];
-  dictionary temp_dict;
   const dictionary & source1 = context.at(dict_name[1]);
   const dictionary & source2 = context.at(dict_name[2]);
-  auto iter = source1.cbegin();
-  auto end_iter = source1.cend();
-  while (iter != end_iter)
-  {
-    if (source2.find(iter->first) != source2.cend())
-    {
-      temp_dict.insert(*iter);
-    }
-    ++iter;
-  }
-  if (context.find(dict_name[0]) != context.end())
-  {
-    context.at(dict_name[0]).clear();
-    context.at(dict_name[0]) = std::move(temp_dict);
-  }
-  else
-  {
-    context.insert(std::make_pair(dict_name[0], std::move(temp_dict)));
-  }
+  dictionary temp_dict(source1);
+  temp_dict.set_intersection(source2);
+  storeResult(context, dict_name[0], std::move(temp_dict));
 }
 
 void erohin::unite(collection & context, std::istream & input, std::ostream &)
 {
   std::string dict_name[3];
   input >> dict_name[0] >> dict_name[1] >> dict_name[2];
-  dictionary temp_dict;
   const dictionary & source1 = context.at(dict_name[1]);
   const dictionary & source2 = context.at(dict_name[2]);
-  temp_dict.insert(source1.cbegin(), source1.cend());
-  temp_dict.insert(source2.cbegin(), source2.cend());
-  if (context.find(dict_name[0]) != context.end())
-  {
-    context.at(dict_name[0]).clear();
-    context.at(dict_name[0]) = std::move(temp_dict);
-  }
-  else
-  {
-    context.insert(std::make_pair(dict_name[0], std::move(temp_dict)));
-  }
+  dictionary temp_dict(source1);
+  temp_dict.set_union(source2);
+  storeResult(context, dict_name[0], std::move(temp_dict));
 }
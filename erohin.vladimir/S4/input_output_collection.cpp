@@ -33,7 +33,7 @@ void erohin::outputCollection(std::ostream & output, const collection & source)
     output << iter->first;
     const dictionary & cur_dict = iter->second;
     auto dict_iter = cur_dict.cbegin();
-    auto dict_end_iter = cur_dict.cbegin();
+    auto dict_end_iter = cur_dict.cend();
     while (dict_iter != dict_end_iter)
     {
       output << " " << dict_iter->first << " " << dict_iter->second;
@@ -43,3 +43,12 @@ void erohin::outputCollection(std::ostream & output, const collection & source)
     ++iter;
   }
 }
+
+void erohin::freezeCollection(collection & source)
+{
+  for (auto iter = source.begin(); iter != source.end(); ++iter)
+  {
+    iter->second.freeze();
+  }
+  source.freeze();
+}
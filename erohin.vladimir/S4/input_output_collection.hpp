@@ -12,6 +12,7 @@ namespace erohin
 
   void inputCollection(std::istream & input, collection & dest);
   void outputCollection(std::ostream & output, const collection & source);
+  void freezeCollection(collection & source);
 }
 
 #endif
@@ -7,6 +7,7 @@
 #include <limits>
 #include "dictionary_command.hpp"
 #include "input_output_collection.hpp"
+#include "collection_snapshot.hpp"
 #include "red_black_tree.hpp"
 
 int main(int argc, char ** argv)
@@ -17,9 +18,15 @@ int main(int argc, char ** argv)
     std::cerr << "Wrong CLA number\n";
     return 1;
   }
-  std::fstream file(argv[1]);
   collection context;
-  inputCollection(file, context);
+  if (!loadSnapshot(argv[1], context))
+  {
+    std::ifstream file(argv[1]);
+    inputCollection(file, context);
+    file.close();
+    saveSnapshot(argv[1], context);
+  }
+  freezeCollection(context);
   commands_source command;
   {
     using namespace std::placeholders;
@@ -28,6 +35,7 @@ int main(int argc, char ** argv)
     command.insert(std::make_pair("intersect", std::bind(intersect, std::ref(context), _1, _2)));
     command.insert(std::make_pair("union", std::bind(unite, std::ref(context), _1, _2)));
   }
+  command.freeze();
   std::string command_name;
   std::cin >> command_name;
   while (!std::cin.eof())
@@ -47,7 +55,5 @@ int main(int argc, char ** argv)
     }
     std::cin >> command_name;
   }
-  outputCollection(file, context);
-  file.close();
   return 0;
 }
@@ -1,16 +1,29 @@
 #include "complement_functor.hpp"
 #include <string>
 #include <limits>
+#include <memory>
 #include <stdexcept>
 
 erohin::ComplementFunctor::ComplementFunctor():
-  sum(0)
+  sum(0),
+  sink(nullptr)
+{}
+
+erohin::ComplementFunctor::ComplementFunctor(OutputSink & output):
+  sum(0),
+  sink(std::addressof(output))
 {}
 
 erohin::ComplementFunctor::~ComplementFunctor() = default;
 
 erohin::ComplementFunctor erohin::ComplementFunctor::operator()(const std::pair< int, std::string > & pair)
 {
+  if (sink)
+  {
+    sink->put(' ');
+    sink->write(pair.second.data(), pair.second.size());
+    return *this;
+  }
   if (sum > 0 && std::numeric_limits< int >::max() - sum < pair.first)
   {
     throw std::overflow_error("Overflow of number");
@@ -20,6 +33,5 @@ erohin::ComplementFunctor erohin::ComplementFunctor::operator()(const std::pair<
     throw std::underflow_error("Underflow of number");
   }
   sum += pair.first;
-  names += (' ' + pair.second);
   return *this;
 }
@@ -2,14 +2,19 @@
 #define COMPLEMENT_FUNCTOR
 
 #include <string>
+#include "output_sink.hpp"
 
 namespace erohin
 {
+  // Without a sink the functor only sums keys; with one it only writes
+  // " name" for every pair, so printing takes one pass of each kind and
+  // never holds the names in memory.
   struct ComplementFunctor
   {
     int sum;
-    std::string names;
+    OutputSink * sink;
     ComplementFunctor();
+    explicit ComplementFunctor(OutputSink & output);
     ~ComplementFunctor();
     ComplementFunctor operator()(const std::pair< int, std::string > & pair);
   };
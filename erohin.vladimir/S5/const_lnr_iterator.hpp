@@ -4,7 +4,6 @@
 #include <utility>
 #include <iterator>
 #include "tree_node.hpp"
-#include "stack.hpp"
 
 namespace erohin
 {
@@ -38,54 +37,35 @@ namespace erohin
     bool operator!=(const ConstLnrIterator< Key, T > & rhs) const;
   private:
     const detail::TreeNode< Key, T > * node_;
-    Stack< const detail::TreeNode< Key, T > * > stack_;
-    explicit ConstLnrIterator(const detail::TreeNode< Key, T > * node_ptr);
+    const detail::TreeNode< Key, T > * root_;
+    ConstLnrIterator(const detail::TreeNode< Key, T > * node_ptr, const detail::TreeNode< Key, T > * root_ptr);
   };
 
   template< class Key, class T >
   ConstLnrIterator< Key, T >::ConstLnrIterator():
-    node_(nullptr)
+    node_(nullptr),
+    root_(nullptr)
   {}
 
   template< class Key, class T >
-  ConstLnrIterator< Key, T >::ConstLnrIterator(const detail::TreeNode< Key, T > * node_ptr):
-    node_(node_ptr)
+  ConstLnrIterator< Key, T >::ConstLnrIterator(const detail::TreeNode< Key, T > * node_ptr, const detail::TreeNode< Key, T > * root_ptr):
+    node_(node_ptr),
+    root_(root_ptr)
   {}
 
   template< class Key, class T >
   ConstLnrIterator< Key, T > & ConstLnrIterator< Key, T >::operator++()
   {
-    if (node_->right)
+    if (node_)
     {
-      stack_.push(node_);
-      node_ = node_->right;
-      while (node_->left)
-      {
-        stack_.push(node_);
-        node_ = node_->left;
-      }
+      node_ = node_->next();
     }
     else
     {
-      if (stack_.empty())
-      {
-        node_ = nullptr;
-        return *this;
-      }
-      while (stack_.top()->right == node_)
-      {
-        node_ = stack_.top();
-        stack_.pop();
-        if (stack_.empty())
-        {
-          node_ = nullptr;
-          return *this;
-        }
-      }
-      while (!stack_.empty() && stack_.top()->left == node_)
+      node_ = root_;
+      while (node_ && node_->left)
       {
-        node_ = stack_.top();
-        stack_.pop();
+        node_ = node_->left;
       }
     }
     return *this;
@@ -102,37 +82,16 @@ namespace erohin
   template< class Key, class T >
   ConstLnrIterator< Key, T > & ConstLnrIterator< Key, T >::operator--()
   {
-    if (node_->left)
+    if (node_)
     {
-      stack_.push(node_);
-      node_ = node_->left;
-      while (node_->right)
-      {
-        stack_.push(node_);
-        node_ = node_->right;
-      }
+      node_ = node_->prev();
     }
     else
     {
-      if (stack_.empty())
-      {
-        node_ = nullptr;
-        return *this;
-      }
-      while (stack_.top()->left == node_)
-      {
-        node_ = stack_.top();
-        stack_.pop();
-        if (stack_.empty())
-        {
-          node_ = nullptr;
-          return *this;
-        }
-      }
-      while (!stack_.empty() && stack_.top()->right == node_)
+      node_ = root_;
+      while (node_ && node_->right)
       {
-        node_ = stack_.top();
-        stack_.pop();
+        node_ = node_->right;
       }
     }
     return *this;
@@ -2,6 +2,7 @@
 #define CONST_RNL_ITERATOR
 
 #include <utility>
+#include <cstddef>
 #include <iterator>
 #include "tree_node.hpp"
 #include "const_lnr_iterator.hpp"
@@ -12,11 +13,16 @@ namespace erohin
   class RedBlackTree;
 
   template< class Key, class T >
-  class ConstRnlIterator: public std::iterator< std::bidirectional_iterator_tag, const std::pair< Key, T > >
+  class ConstRnlIterator
   {
     template < class T1, class T2, class T3 >
     friend class RedBlackTree;
   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = const std::pair< Key, T >;
+    using difference_type = std::ptrdiff_t;
+    using pointer = value_type *;
+    using reference = value_type &;
     ConstRnlIterator() = default;
     ConstRnlIterator(const ConstRnlIterator< Key, T > &) = default;
     ~ConstRnlIterator() = default;
@@ -31,13 +37,13 @@ namespace erohin
     bool operator!=(const ConstRnlIterator< Key, T > & rhs) const;
   private:
     ConstLnrIterator< Key, T > iter_;
-    explicit ConstRnlIterator(const detail::TreeNode< Key, T > * node_ptr);
+    ConstRnlIterator(const detail::TreeNode< Key, T > * node_ptr, const detail::TreeNode< Key, T > * root_ptr);
     explicit ConstRnlIterator(ConstLnrIterator< Key, T > iter);
   };
 
   template< class Key, class T >
-  ConstRnlIterator< Key, T >::ConstRnlIterator(const detail::TreeNode< Key, T > * node_ptr):
-    iter_(ConstLnrIterator< Key, T >(node_ptr))
+  ConstRnlIterator< Key, T >::ConstRnlIterator(const detail::TreeNode< Key, T > * node_ptr, const detail::TreeNode< Key, T > * root_ptr):
+    iter_(ConstLnrIterator< Key, T >(node_ptr, root_ptr))
   {}
 
   template< class Key, class T >
@@ -48,25 +54,31 @@ namespace erohin
   template< class Key, class T >
   ConstRnlIterator< Key, T > & ConstRnlIterator< Key, T >::operator++()
   {
-    return ConstRnlIterator< Key, T >(--iter_);
+    --iter_;
+    return *this;
   }
 
   template< class Key, class T >
   ConstRnlIterator< Key, T > ConstRnlIterator< Key, T >::operator++(int)
   {
-    return ConstRnlIterator< Key, T >(iter_--);
+    ConstRnlIterator< Key, T > temp = *this;
+    --iter_;
+    return temp;
   }
 
   template< class Key, class T >
   ConstRnlIterator< Key, T > & ConstRnlIterator< Key, T >::operator--()
   {
-    return ConstRnlIterator< Key, T >(++iter_);
+    ++iter_;
+    return *this;
   }
 
   template< class Key, class T >
   ConstRnlIterator< Key, T > ConstRnlIterator< Key, T >::operator--(int)
   {
-    return ConstRnlIterator< Key, T >(iter_--);
+    ConstRnlIterator< Key, T > temp = *this;
+    ++iter_;
+    return temp;
   }
 
   template< class Key, class T >
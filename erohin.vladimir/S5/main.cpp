@@ -4,6 +4,7 @@
 #include <stdexcept>
 #include "red_black_tree.hpp"
 #include "complement_functor.hpp"
+#include "output_sink.hpp"
 
 int main(int argc, char ** argv)
 {
@@ -49,9 +50,13 @@ int main(int argc, char ** argv)
   {
     try
     {
-      ComplementFunctor functor;
-      functor = traversal.at(argv[1])(functor);
-      std::cout << functor.sum << functor.names << "\n";
+      const traversal_func & traverse = traversal.at(argv[1]);
+      int sum = traverse(ComplementFunctor()).sum;
+      std::cout << sum;
+      OutputSink sink(std::cout);
+      traverse(ComplementFunctor(sink));
+      sink.put('\n');
+      sink.flush();
     }
     catch (const std::exception & e)
     {
@@ -0,0 +1,49 @@
+#include "output_sink.hpp"
+#include <cstring>
+#include <ostream>
+
+erohin::OutputSink::OutputSink(std::ostream & output):
+  output_(output),
+  size_(0)
+{}
+
+erohin::OutputSink::~OutputSink()
+{
+  try
+  {
+    flush();
+  }
+  catch (...)
+  {}
+}
+
+void erohin::OutputSink::put(char c)
+{
+  if (size_ == capacity)
+  {
+    flush();
+  }
+  buffer_[size_++] = c;
+}
+
+void erohin::OutputSink::write(const char * data, size_t size)
+{
+  if (capacity - size_ < size)
+  {
+    flush();
+    if (size >= capacity)
+    {
+      output_.write(data, size);
+      return;
+    }
+  }
+  std::memcpy(buffer_ + size_, data, size);
+  size_ += size;
+}
+
+void erohin::OutputSink::flush()
+{
+  output_.write(buffer_, size_);
+  size_ = 0;
+  output_.flush();
+}
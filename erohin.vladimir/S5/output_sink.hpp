@@ -0,0 +1,27 @@
+#ifndef OUTPUT_SINK
+#define OUTPUT_SINK
+
+#include <cstddef>
+#include <iosfwd>
+
+namespace erohin
+{
+  class OutputSink
+  {
+  public:
+    explicit OutputSink(std::ostream & output);
+    OutputSink(const OutputSink &) = delete;
+    ~OutputSink();
+    OutputSink & operator=(const OutputSink &) = delete;
+    void put(char c);
+    void write(const char * data, size_t size);
+    void flush();
+  private:
+    static constexpr size_t capacity = 1 << 16;
+    std::ostream & output_;
+    size_t size_;
+    char buffer_[capacity];
+  };
+}
+
+#endif
@@ -2,6 +2,7 @@
 #define RNL_ITERATOR
 
 #include <utility>
+#include <cstddef>
 #include <iterator>
 #include "tree_node.hpp"
 #include "lnr_iterator.hpp"
@@ -12,11 +13,16 @@ namespace erohin
   class RedBlackTree;
 
   template< class Key, class T >
-  class RnlIterator: public std::iterator< std::bidirectional_iterator_tag, std::pair< Key, T > >
+  class RnlIterator
   {
     template < class T1, class T2, class T3 >
     friend class RedBlackTree;
   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = std::pair< Key, T >;
+    using difference_type = std::ptrdiff_t;
+    using pointer = value_type *;
+    using reference = value_type &;
     RnlIterator() = default;
     RnlIterator(const RnlIterator< Key, T > &) = default;
     ~RnlIterator() = default;
@@ -33,13 +39,13 @@ namespace erohin
     bool operator!=(const RnlIterator< Key, T > & rhs) const;
   private:
     LnrIterator< Key, T > iter_;
-    explicit RnlIterator(detail::TreeNode< Key, T > * node_ptr);
+    RnlIterator(detail::TreeNode< Key, T > * node_ptr, detail::TreeNode< Key, T > * root_ptr);
     explicit RnlIterator(LnrIterator< Key, T > iter);
   };
 
   template< class Key, class T >
-  RnlIterator< Key, T >::RnlIterator(detail::TreeNode< Key, T > * node_ptr):
-    iter_(LnrIterator< Key, T >(node_ptr))
+  RnlIterator< Key, T >::RnlIterator(detail::TreeNode< Key, T > * node_ptr, detail::TreeNode< Key, T > * root_ptr):
+    iter_(LnrIterator< Key, T >(node_ptr, root_ptr))
   {}
 
   template< class Key, class T >
@@ -50,25 +56,31 @@ namespace erohin
   template< class Key, class T >
   RnlIterator< Key, T > & RnlIterator< Key, T >::operator++()
   {
-    return (--iter_);
+    --iter_;
+    return *this;
   }
 
   template< class Key, class T >
   RnlIterator< Key, T > RnlIterator< Key, T >::operator++(int)
   {
-    return (iter_--);
+    RnlIterator< Key, T > temp = *this;
+    --iter_;
+    return temp;
   }
 
   template< class Key, class T >
   RnlIterator< Key, T > & RnlIterator< Key, T >::operator--()
   {
-    return (++iter_);
+    ++iter_;
+    return *this;
   }
 
   template< class Key, class T >
   RnlIterator< Key, T > RnlIterator< Key, T >::operator--(int)
   {
-    return (iter_--);
+    RnlIterator< Key, T > temp = *this;
+    ++iter_;
+    return temp;
   }
 
   template< class Key, class T >
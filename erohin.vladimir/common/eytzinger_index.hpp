@@ -0,0 +1,164 @@
+#ifndef EYTZINGER_INDEX_HPP
+#define EYTZINGER_INDEX_HPP
+
+#include <cstddef>
+#include <memory>
+#include "dynamic_array.hpp"
+#include "tree_node.hpp"
+
+namespace erohin
+{
+  namespace detail
+  {
+    // Read-only copy of the keys of a tree laid out in BFS order: the children
+    // of slot i are 2i + 1 and 2i + 2, so the top levels of every search share
+    // the same few cache lines. Slots point back to the tree nodes for values.
+    template< class Key, class T, class Compare >
+    class EytzingerIndex
+    {
+    public:
+      EytzingerIndex(TreeNode< Key, T > * first, size_t count, const Compare & cmp);
+      TreeNode< Key, T > * find(const Key & key) const;
+      TreeNode< Key, T > * lower_bound(const Key & key) const;
+      TreeNode< Key, T > * upper_bound(const Key & key) const;
+      template< class F >
+      F traverse(F f) const;
+      size_t size() const noexcept;
+    private:
+      DynamicArray< Key > keys_;
+      DynamicArray< TreeNode< Key, T > * > nodes_;
+      Compare cmp_;
+      void fill(size_t index, TreeNode< Key, T > *& current);
+      template< bool Inclusive >
+      TreeNode< Key, T > * descend(const Key & key) const;
+      void prefetch(size_t index) const;
+    };
+
+    template< class Key, class T, class Compare >
+    EytzingerIndex< Key, T, Compare >::EytzingerIndex(TreeNode< Key, T > * first, size_t count, const Compare & cmp):
+      cmp_(cmp)
+    {
+      for (size_t i = 0; i < count; ++i)
+      {
+        nodes_.push_back(nullptr);
+      }
+      fill(0, first);
+      for (size_t i = 0; i < count; ++i)
+      {
+        keys_.push_back(nodes_[i]->data.first);
+      }
+    }
+
+    template< class Key, class T, class Compare >
+    TreeNode< Key, T > * EytzingerIndex< Key, T, Compare >::find(const Key & key) const
+    {
+      TreeNode< Key, T > * node = lower_bound(key);
+      return (node && !cmp_(key, node->data.first)) ? node : nullptr;
+    }
+
+    template< class Key, class T, class Compare >
+    TreeNode< Key, T > * EytzingerIndex< Key, T, Compare >::lower_bound(const Key & key) const
+    {
+      return descend< false >(key);
+    }
+
+    template< class Key, class T, class Compare >
+    TreeNode< Key, T > * EytzingerIndex< Key, T, Compare >::upper_bound(const Key & key) const
+    {
+      return descend< true >(key);
+    }
+
+    template< class Key, class T, class Compare >
+    template< class F >
+    F EytzingerIndex< Key, T, Compare >::traverse(F f) const
+    {
+      const size_t count = nodes_.size();
+      if (!count)
+      {
+        return f;
+      }
+      size_t index = 0;
+      while (2 * index + 1 < count)
+      {
+        index = 2 * index + 1;
+      }
+      while (true)
+      {
+        f = f(nodes_[index]->data);
+        if (2 * index + 2 < count)
+        {
+          index = 2 * index + 2;
+          while (2 * index + 1 < count)
+          {
+            index = 2 * index + 1;
+          }
+          continue;
+        }
+        while (index && index % 2 == 0)
+        {
+          index = (index - 2) / 2;
+        }
+        if (!index)
+        {
+          return f;
+        }
+        index = (index - 1) / 2;
+      }
+    }
+
+    template< class Key, class T, class Compare >
+    size_t EytzingerIndex< Key, T, Compare >::size() const noexcept
+    {
+      return nodes_.size();
+    }
+
+    template< class Key, class T, class Compare >
+    void EytzingerIndex< Key, T, Compare >::fill(size_t index, TreeNode< Key, T > *& current)
+    {
+      if (index >= nodes_.size())
+      {
+        return;
+      }
+      fill(2 * index + 1, current);
+      nodes_[index] = current;
+      current = current->next();
+      fill(2 * index + 2, current);
+    }
+
+    template< class Key, class T, class Compare >
+    template< bool Inclusive >
+    TreeNode< Key, T > * EytzingerIndex< Key, T, Compare >::descend(const Key & key) const
+    {
+      const size_t count = keys_.size();
+      size_t index = 0;
+      while (index < count)
+      {
+        prefetch(16 * index + 15);
+        bool go_right = Inclusive ? !cmp_(key, keys_[index]) : cmp_(keys_[index], key);
+        index = 2 * index + 1 + static_cast< size_t >(go_right);
+      }
+      size_t position = index + 1;
+      while (position & 1)
+      {
+        position >>= 1;
+      }
+      position >>= 1;
+      return position ? nodes_[position - 1] : nullptr;
+    }
+
+    template< class Key, class T, class Compare >
+    void EytzingerIndex< Key, T, Compare >::prefetch(size_t index) const
+    {
+#if defined(__GNUC__)
+      if (index < keys_.size())
+      {
+        __builtin_prefetch(std::addressof(keys_[index]));
+      }
+#else
+      (void) index;
+#endif
+    }
+  }
+}
+
+#endif
@@ -3,7 +3,13 @@
 
 #include <functional>
 #include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include "queue.hpp"
 #include "tree_node.hpp"
+#include "tree_join.hpp"
+#include "eytzinger_index.hpp"
 #include "tree_const_iterator.hpp"
 #include "tree_iterator.hpp"
 
@@ -94,11 +100,40 @@ namespace erohin
     F traverse_rnl(F f) const;
     template< class F >
     F traverse_breadth(F f) const;
+    RedBlackTree< Key, T, Compare > split(const Key & key);
+    void join(RedBlackTree< Key, T, Compare > && rhs);
+    void set_union(const RedBlackTree< Key, T, Compare > & rhs);
+    void set_union(const RedBlackTree< Key, T, Compare > & rhs, ThreadPool & pool);
+    void set_intersection(const RedBlackTree< Key, T, Compare > & rhs);
+    void set_intersection(const RedBlackTree< Key, T, Compare > & rhs, ThreadPool & pool);
+    void set_difference(const RedBlackTree< Key, T, Compare > & rhs);
+    void set_difference(const RedBlackTree< Key, T, Compare > & rhs, ThreadPool & pool);
+    void freeze();
+    void thaw() noexcept;
+    bool is_frozen() const noexcept;
   private:
     detail::TreeNode< Key, T > * root_;
     Compare cmp_;
     size_t size_;
+    detail::EytzingerIndex< Key, T, Compare > * frozen_;
     void clear_subtree(detail::TreeNode< Key, T > * subtree);
+    void set_union_impl(const RedBlackTree< Key, T, Compare > & rhs, ThreadPool * pool);
+    void set_intersection_impl(const RedBlackTree< Key, T, Compare > & rhs, ThreadPool * pool);
+    void set_difference_impl(const RedBlackTree< Key, T, Compare > & rhs, ThreadPool * pool);
+    template< class InputIt >
+    void insert_range(InputIt first, InputIt last, std::input_iterator_tag);
+    template< class FwdIt >
+    void insert_range(FwdIt first, FwdIt last, std::forward_iterator_tag);
+    template< class FwdIt >
+    bool is_sorted_unique(FwdIt first, FwdIt last) const;
+    template< class FwdIt >
+    void merge_sorted(FwdIt first, FwdIt last);
+    template< class InputIt >
+    detail::TreeNode< Key, T > * make_chain(InputIt first, InputIt last, size_t & count);
+    void clear_chain(detail::TreeNode< Key, T > * chain);
+    void flatten(detail::TreeNode< Key, T > * subtree, detail::TreeNode< Key, T > *& chain);
+    void build_from_chain(detail::TreeNode< Key, T > * chain, size_t count);
+    detail::TreeNode< Key, T > * link_chain(detail::TreeNode< Key, T > *& chain, size_t count, size_t depth, size_t red_depth);
     detail::TreeNode< Key, T > * find_to_change_erased(detail::TreeNode< Key, T > * subtree);
     detail::TreeNode< Key, T > * find_grandparent(detail::TreeNode< Key, T > * subtree);
     detail::TreeNode< Key, T > * find_uncle(detail::TreeNode< Key, T > * subtree);
@@ -126,21 +161,31 @@ namespace erohin
   template< class Key, class T, class Compare >
   RedBlackTree< Key, T, Compare >::RedBlackTree():
     root_(nullptr),
-    size_(0)
+    size_(0),
+    frozen_(nullptr)
   {}
 
   template< class Key, class T, class Compare >
   RedBlackTree< Key, T, Compare >::RedBlackTree(const RedBlackTree< Key, T, Compare > & rhs):
-    RedBlackTree(rhs.cbegin(), rhs.cend())
-  {}
+    root_(nullptr),
+    cmp_(rhs.cmp_),
+    size_(0),
+    frozen_(nullptr)
+  {
+    size_t count = 0;
+    detail::TreeNode< Key, T > * chain = make_chain(rhs.cbegin(), rhs.cend(), count);
+    build_from_chain(chain, count);
+  }
 
   template< class Key, class T, class Compare >
   RedBlackTree< Key, T, Compare >::RedBlackTree(RedBlackTree< Key, T, Compare > && rhs) noexcept:
     root_(rhs.root_),
-    size_(rhs.size_)
+    size_(rhs.size_),
+    frozen_(rhs.frozen_)
   {
     rhs.root_ = nullptr;
     rhs.size_ = 0;
+    rhs.frozen_ = nullptr;
   }
 
   template< class Key, class T, class Compare >
@@ -151,18 +196,18 @@ namespace erohin
   template< class Key, class T, class Compare >
   template< class InputIt >
   RedBlackTree< Key, T, Compare >::RedBlackTree(InputIt first, InputIt last):
-    root_(nullptr)
+    root_(nullptr),
+    size_(0),
+    frozen_(nullptr)
   {
-    while (first != last)
+    try
     {
-      try
-      {
-        insert(*(first++));
-      }
-      catch (...)
-      {
-        clear();
-      }
+      insert(first, last);
+    }
+    catch (...)
+    {
+      clear();
+      throw;
     }
   }
 
@@ -273,67 +318,49 @@ namespace erohin
   template< class Key, class T, class Compare >
   LnrIterator< Key, T > RedBlackTree< Key, T, Compare >::lnr_begin()
   {
-    auto iter = lnr_iterator(root_);
-    while (iter.node_->left)
-    {
-      iter.stack_.push(iter.node_);
-      iter.node_ = iter.node_->left;
-    }
-    return iter;
+    return lnr_iterator(begin().node_, root_);
   }
 
   template< class Key, class T, class Compare >
   LnrIterator< Key, T > RedBlackTree< Key, T, Compare >::lnr_end()
   {
-    return lnr_iterator(nullptr);
+    return lnr_iterator(nullptr, root_);
   }
 
   template< class Key, class T, class Compare >
   ConstLnrIterator< Key, T > RedBlackTree< Key, T, Compare >::lnr_cbegin() const
   {
-    auto iter = const_lnr_iterator(root_);
-    while (iter.node_->left)
-    {
-      iter.stack_.push(iter.node_);
-      iter.node_ = iter.node_->left;
-    }
-    return iter;
+    return const_lnr_iterator(cbegin().node_, root_);
   }
 
   template< class Key, class T, class Compare >
   ConstLnrIterator< Key, T > RedBlackTree< Key, T, Compare >::lnr_cend() const
   {
-    return const_lnr_iterator(nullptr);
+    return const_lnr_iterator(nullptr, root_);
   }
 
   template< class Key, class T, class Compare >
   typename RedBlackTree< Key, T, Compare >::rnl_iterator RedBlackTree< Key, T, Compare >::rnl_begin()
   {
-    return rnl_iterator(rnl_cbegin().iter_);
+    return rnl_iterator(--lnr_end());
   }
 
   template< class Key, class T, class Compare >
   typename RedBlackTree< Key, T, Compare >::rnl_iterator RedBlackTree< Key, T, Compare >::rnl_end()
   {
-    return rnl_iterator(rnl_cend().iter_);
+    return rnl_iterator(nullptr, root_);
   }
 
   template< class Key, class T, class Compare >
   typename RedBlackTree< Key, T, Compare >::const_rnl_iterator RedBlackTree< Key, T, Compare >::rnl_cbegin() const
   {
-    auto iter = const_lnr_iterator(root_);
-    while (iter.node_->right)
-    {
-      iter.stack_.push(iter.node_);
-      iter.node_ = iter.node_->right;
-    }
-    return const_rnl_iterator(iter);
+    return const_rnl_iterator(--lnr_cend());
   }
 
   template< class Key, class T, class Compare >
   typename RedBlackTree< Key, T, Compare >::const_rnl_iterator RedBlackTree< Key, T, Compare >::rnl_cend() const
   {
-    return const_rnl_iterator(nullptr);
+    return const_rnl_iterator(nullptr, root_);
   }
 
   template< class Key, class T, class Compare >
@@ -363,6 +390,7 @@ namespace erohin
   template< class Key, class T, class Compare >
   void RedBlackTree< Key, T, Compare >::clear()
   {
+    thaw();
     clear_subtree(root_);
     root_ = nullptr;
     size_ = 0;
@@ -377,6 +405,7 @@ namespace erohin
   template< class Key, class T, class Compare >
   std::pair< TreeIterator< Key, T >, bool > RedBlackTree< Key, T, Compare >::insert(value_type && value)
   {
+    thaw();
     detail::TreeNode< Key, T > * node = root_;
     if (empty())
     {
@@ -434,6 +463,7 @@ namespace erohin
   template< class Key, class T, class Compare >
   TreeIterator< Key, T > RedBlackTree< Key, T, Compare >::insert(iterator pos, value_type && value)
   {
+    thaw();
     detail::TreeNode< Key, T > * node = pos.node_;
     detail::TreeNode< Key, T > * prev = node;
     while (node)
@@ -474,10 +504,8 @@ namespace erohin
   template< class InputIt >
   void RedBlackTree< Key, T, Compare >::insert(InputIt first, InputIt last)
   {
-    while (first != last)
-    {
-      insert(*(first++));
-    }
+    thaw();
+    insert_range(first, last, typename std::iterator_traits< InputIt >::iterator_category());
   }
 
   template< class Key, class T, class Compare >
@@ -490,6 +518,7 @@ namespace erohin
   template< class... Args >
   std::pair< TreeIterator< Key, T >, bool > RedBlackTree< Key, T, Compare >::emplace(Args &&... args)
   {
+    thaw();
     detail::TreeNode< Key, T > * emplaced = new detail::TreeNode< Key, T >(nullptr, nullptr, nullptr, std::forward< Args... >(args...));
     try
     {
@@ -543,6 +572,7 @@ namespace erohin
   template< class... Args >
   TreeIterator< Key, T > RedBlackTree< Key, T, Compare >::emplace_hint(const_iterator pos, Args &&... args)
   {
+    thaw();
     detail::TreeNode< Key, T > * emplaced = new detail::TreeNode< Key, T >(nullptr, nullptr, nullptr, std::forward< Args... >(args...));
     try
     {
@@ -615,6 +645,7 @@ namespace erohin
   template< class Key, class T, class Compare >
   TreeIterator< Key, T > RedBlackTree< Key, T, Compare >::erase(iterator pos)
   {
+    thaw();
     detail::TreeNode< Key, T > * to_delete = pos.node_;
     detail::TreeNode< Key, T > * found = find_to_change_erased(to_delete);
     if (to_delete == root_ && !found)
@@ -678,6 +709,9 @@ namespace erohin
   void RedBlackTree< Key, T, Compare >::swap(RedBlackTree< Key, T, Compare > & rhs) noexcept
   {
     std::swap(root_, rhs.root_);
+    std::swap(cmp_, rhs.cmp_);
+    std::swap(size_, rhs.size_);
+    std::swap(frozen_, rhs.frozen_);
   }
 
   template< class Key, class T, class Compare >
@@ -689,21 +723,16 @@ namespace erohin
   template< class Key, class T, class Compare >
   size_t RedBlackTree< Key, T, Compare >::count(const Key & key) const
   {
-    auto citer = cbegin();
-    size_t size = 0;
-    while (citer != cend())
-    {
-      if (!cmp_(key, citer->first) && !cmp_(citer->first, key))
-      {
-        ++size;
-      }
-    }
-    return size;
+    return (find(key) != cend()) ? 1 : 0;
   }
 
   template< class Key, class T, class Compare >
   TreeIterator< Key, T > RedBlackTree< Key, T, Compare >::find(const Key & key)
   {
+    if (frozen_)
+    {
+      return iterator(frozen_->find(key));
+    }
     detail::TreeNode< Key, T > * node = root_;
     while (node)
     {
@@ -726,6 +755,10 @@ namespace erohin
   template< class Key, class T, class Compare >
   TreeConstIterator< Key, T > RedBlackTree< Key, T, Compare >::find(const Key & key) const
   {
+    if (frozen_)
+    {
+      return const_iterator(frozen_->find(key));
+    }
     const detail::TreeNode< Key, T > * node = root_;
     while (node)
     {
@@ -770,45 +803,47 @@ namespace erohin
   template< class Key, class T, class Compare >
   TreeIterator< Key, T > RedBlackTree< Key, T, Compare >::lower_bound(const Key & key)
   {
+    if (frozen_)
+    {
+      return iterator(frozen_->lower_bound(key));
+    }
     detail::TreeNode< Key, T > * node = root_;
-    detail::TreeNode< Key, T > * prev = root_;
+    detail::TreeNode< Key, T > * result = nullptr;
     while (node)
     {
-      prev = node;
-      if (cmp_(key, node->data.first))
+      if (!cmp_(node->data.first, key))
       {
+        result = node;
         node = node->left;
       }
       else
       {
         node = node->right;
       }
-      if (!cmp_(prev->data.first, key))
-      {
-        return iterator(node);
-      }
     }
-    return end();
+    return iterator(result);
   }
 
   template< class Key, class T, class Compare >
   TreeConstIterator< Key, T > RedBlackTree< Key, T, Compare >::lower_bound(const Key & key) const
   {
-    return const_iterator(lower_bound(key).node_);
+    return const_iterator(const_cast< RedBlackTree< Key, T, Compare > * >(this)->lower_bound(key).node_);
   }
 
   template< class Key, class T, class Compare >
   TreeIterator< Key, T > RedBlackTree< Key, T, Compare >::upper_bound(const Key & key)
   {
+    if (frozen_)
+    {
+      return iterator(frozen_->upper_bound(key));
+    }
     detail::TreeNode< Key, T > * node = root_;
+    detail::TreeNode< Key, T > * result = nullptr;
     while (node)
     {
-      if (cmp_(node->data.first, key))
-      {
-        return iterator(node);
-      }
-      else if (cmp_(key, node->data.first))
+      if (cmp_(key, node->data.first))
       {
+        result = node;
         node = node->left;
       }
       else
@@ -816,13 +851,13 @@ namespace erohin
         node = node->right;
       }
     }
-    return end();
+    return iterator(result);
   }
 
   template< class Key, class T, class Compare >
   TreeConstIterator< Key, T > RedBlackTree< Key, T, Compare >::upper_bound(const Key & key) const
   {
-    return const_iterator(upper_bound(key).node_);
+    return const_iterator(const_cast< RedBlackTree< Key, T, Compare > * >(this)->upper_bound(key).node_);
   }
 
   template< class Key, class T, class Compare >
@@ -841,6 +876,10 @@ namespace erohin
   template< class F >
   F RedBlackTree< Key, T, Compare >::traverse_lnr(F f) const
   {
+    if (frozen_)
+    {
+      return frozen_->traverse(f);
+    }
     auto citer = lnr_cbegin();
     while (citer != lnr_cend())
     {
@@ -865,14 +904,207 @@ namespace erohin
   template< class F >
   F RedBlackTree< Key, T, Compare >::traverse_breadth(F f) const
   {
-    auto citer = breadth_cbegin();
-    while (citer != breadth_cend())
+    if (!root_)
     {
-      f = f(*(citer++));
+      return f;
+    }
+    Queue< const detail::TreeNode< Key, T > * > level;
+    level.push(root_);
+    while (!level.empty())
+    {
+      const detail::TreeNode< Key, T > * node = level.front();
+      level.pop();
+      if (node->left)
+      {
+        level.push(node->left);
+      }
+      if (node->right)
+      {
+        level.push(node->right);
+      }
+      f = f(node->data);
     }
     return f;
   }
 
+  template< class Key, class T, class Compare >
+  RedBlackTree< Key, T, Compare > RedBlackTree< Key, T, Compare >::split(const Key & key)
+  {
+    thaw();
+    detail::Subtree< Key, T > lower{ nullptr, 0 };
+    detail::Subtree< Key, T > upper{ nullptr, 0 };
+    detail::TreeNode< Key, T > * found = detail::split(detail::make_subtree(root_), key, cmp_, lower, upper);
+    if (found)
+    {
+      upper = detail::join(detail::Subtree< Key, T >{ nullptr, 0 }, found, upper);
+    }
+    RedBlackTree< Key, T, Compare > result;
+    result.cmp_ = cmp_;
+    root_ = lower.root;
+    result.root_ = upper.root;
+    // Counting both halves with a doubling limit stops at the smaller one,
+    // so the sizes cost O(min(k, n - k)) on top of the O(log n) split
+    for (size_t limit = 1; ; limit *= 2)
+    {
+      size_t lower_count = detail::count_nodes(root_, limit);
+      if (lower_count <= limit)
+      {
+        result.size_ = size_ - lower_count;
+        size_ = lower_count;
+        break;
+      }
+      size_t upper_count = detail::count_nodes(result.root_, limit);
+      if (upper_count <= limit)
+      {
+        result.size_ = upper_count;
+        size_ -= upper_count;
+        break;
+      }
+    }
+    return result;
+  }
+
+  template< class Key, class T, class Compare >
+  void RedBlackTree< Key, T, Compare >::join(RedBlackTree< Key, T, Compare > && rhs)
+  {
+    if (std::addressof(rhs) == this || rhs.empty())
+    {
+      return;
+    }
+    thaw();
+    rhs.thaw();
+    if (!empty())
+    {
+      const detail::TreeNode< Key, T > * last = root_;
+      while (last->right)
+      {
+        last = last->right;
+      }
+      if (!cmp_(last->data.first, rhs.cbegin()->first))
+      {
+        throw std::invalid_argument("Joined trees overlap");
+      }
+    }
+    root_ = detail::join(detail::make_subtree(root_), detail::make_subtree(rhs.root_)).root;
+    size_ += rhs.size_;
+    rhs.root_ = nullptr;
+    rhs.size_ = 0;
+  }
+
+  template< class Key, class T, class Compare >
+  void RedBlackTree< Key, T, Compare >::set_union(const RedBlackTree< Key, T, Compare > & rhs)
+  {
+    set_union_impl(rhs, nullptr);
+  }
+
+  template< class Key, class T, class Compare >
+  void RedBlackTree< Key, T, Compare >::set_union(const RedBlackTree< Key, T, Compare > & rhs, ThreadPool & pool)
+  {
+    set_union_impl(rhs, std::addressof(pool));
+  }
+
+  template< class Key, class T, class Compare >
+  void RedBlackTree< Key, T, Compare >::set_union_impl(const RedBlackTree< Key, T, Compare > & rhs, ThreadPool * pool)
+  {
+    thaw();
+    if (std::addressof(rhs) == this)
+    {
+      return;
+    }
+    std::atomic< size_t > added(0);
+    detail::Subtree< Key, T > tree = detail::make_subtree(root_);
+    root_ = nullptr;
+    try
+    {
+      root_ = detail::unite(tree, rhs.root_, detail::black_height(rhs.root_), cmp_, pool, added).root;
+    }
+    catch (...)
+    {
+      size_ = 0;
+      throw;
+    }
+    size_ += added;
+  }
+
+  template< class Key, class T, class Compare >
+  void RedBlackTree< Key, T, Compare >::set_intersection(const RedBlackTree< Key, T, Compare > & rhs)
+  {
+    set_intersection_impl(rhs, nullptr);
+  }
+
+  template< class Key, class T, class Compare >
+  void RedBlackTree< Key, T, Compare >::set_intersection(const RedBlackTree< Key, T, Compare > & rhs, ThreadPool & pool)
+  {
+    set_intersection_impl(rhs, std::addressof(pool));
+  }
+
+  template< class Key, class T, class Compare >
+  void RedBlackTree< Key, T, Compare >::set_intersection_impl(const RedBlackTree< Key, T, Compare > & rhs, ThreadPool * pool)
+  {
+    thaw();
+    if (std::addressof(rhs) == this)
+    {
+      return;
+    }
+    std::atomic< size_t > kept(0);
+    root_ = detail::intersect(detail::make_subtree(root_), rhs.root_, detail::black_height(rhs.root_), cmp_, pool, kept).root;
+    size_ = kept;
+  }
+
+  template< class Key, class T, class Compare >
+  void RedBlackTree< Key, T, Compare >::set_difference(const RedBlackTree< Key, T, Compare > & rhs)
+  {
+    set_difference_impl(rhs, nullptr);
+  }
+
+  template< class Key, class T, class Compare >
+  void RedBlackTree< Key, T, Compare >::set_difference(const RedBlackTree< Key, T, Compare > & rhs, ThreadPool & pool)
+  {
+    set_difference_impl(rhs, std::addressof(pool));
+  }
+
+  template< class Key, class T, class Compare >
+  void RedBlackTree< Key, T, Compare >::set_difference_impl(const RedBlackTree< Key, T, Compare > & rhs, ThreadPool * pool)
+  {
+    thaw();
+    if (std::addressof(rhs) == this)
+    {
+      clear();
+      return;
+    }
+    std::atomic< size_t > removed(0);
+    root_ = detail::subtract(detail::make_subtree(root_), rhs.root_, detail::black_height(rhs.root_), cmp_, pool, removed).root;
+    size_ -= removed;
+  }
+
+  template< class Key, class T, class Compare >
+  void RedBlackTree< Key, T, Compare >::freeze()
+  {
+    if (frozen_)
+    {
+      return;
+    }
+    detail::TreeNode< Key, T > * first = root_;
+    while (first && first->left)
+    {
+      first = first->left;
+    }
+    frozen_ = new detail::EytzingerIndex< Key, T, Compare >(first, size(), cmp_);
+  }
+
+  template< class Key, class T, class Compare >
+  void RedBlackTree< Key, T, Compare >::thaw() noexcept
+  {
+    delete frozen_;
+    frozen_ = nullptr;
+  }
+
+  template< class Key, class T, class Compare >
+  bool RedBlackTree< Key, T, Compare >::is_frozen() const noexcept
+  {
+    return frozen_;
+  }
+
   template< class Key, class T, class Compare >
   void RedBlackTree< Key, T, Compare >::clear_subtree(detail::TreeNode< Key, T > * subtree)
   {
@@ -885,6 +1117,213 @@ namespace erohin
     delete subtree;
   }
 
+  template< class Key, class T, class Compare >
+  template< class InputIt >
+  void RedBlackTree< Key, T, Compare >::insert_range(InputIt first, InputIt last, std::input_iterator_tag)
+  {
+    while (first != last)
+    {
+      insert(*(first++));
+    }
+  }
+
+  template< class Key, class T, class Compare >
+  template< class FwdIt >
+  void RedBlackTree< Key, T, Compare >::insert_range(FwdIt first, FwdIt last, std::forward_iterator_tag)
+  {
+    if (!is_sorted_unique(first, last))
+    {
+      insert_range(first, last, std::input_iterator_tag());
+    }
+    else if (empty())
+    {
+      size_t count = 0;
+      detail::TreeNode< Key, T > * chain = make_chain(first, last, count);
+      build_from_chain(chain, count);
+    }
+    else
+    {
+      size_t count = std::distance(first, last);
+      size_t height = 1;
+      while ((size_t(1) << height) <= size())
+      {
+        ++height;
+      }
+      if (count * height < size() + count)
+      {
+        insert_range(first, last, std::input_iterator_tag());
+      }
+      else
+      {
+        merge_sorted(first, last);
+      }
+    }
+  }
+
+  template< class Key, class T, class Compare >
+  template< class FwdIt >
+  bool RedBlackTree< Key, T, Compare >::is_sorted_unique(FwdIt first, FwdIt last) const
+  {
+    if (first == last)
+    {
+      return true;
+    }
+    FwdIt next = first;
+    while (++next != last)
+    {
+      if (!cmp_((*first).first, (*next).first))
+      {
+        return false;
+      }
+      first = next;
+    }
+    return true;
+  }
+
+  template< class Key, class T, class Compare >
+  template< class FwdIt >
+  void RedBlackTree< Key, T, Compare >::merge_sorted(FwdIt first, FwdIt last)
+  {
+    detail::TreeNode< Key, T > * added = nullptr;
+    detail::TreeNode< Key, T > ** tail = std::addressof(added);
+    size_t added_count = 0;
+    detail::TreeNode< Key, T > * node = begin().node_;
+    try
+    {
+      while (first != last)
+      {
+        if (node && cmp_(node->data.first, (*first).first))
+        {
+          node = node->next();
+        }
+        else if (node && !cmp_((*first).first, node->data.first))
+        {
+          ++first;
+        }
+        else
+        {
+          *tail = new detail::TreeNode< Key, T >(nullptr, nullptr, nullptr, *(first++));
+          tail = std::addressof((*tail)->right);
+          ++added_count;
+        }
+      }
+    }
+    catch (...)
+    {
+      clear_chain(added);
+      throw;
+    }
+    size_t existing_count = size();
+    detail::TreeNode< Key, T > * existing = nullptr;
+    flatten(root_, existing);
+    detail::TreeNode< Key, T > * merged = nullptr;
+    tail = std::addressof(merged);
+    while (existing && added)
+    {
+      detail::TreeNode< Key, T > ** smaller = std::addressof(existing);
+      if (cmp_(added->data.first, existing->data.first))
+      {
+        smaller = std::addressof(added);
+      }
+      *tail = *smaller;
+      tail = std::addressof((*tail)->right);
+      *smaller = (*smaller)->right;
+    }
+    *tail = existing ? existing : added;
+    build_from_chain(merged, existing_count + added_count);
+  }
+
+  template< class Key, class T, class Compare >
+  template< class InputIt >
+  detail::TreeNode< Key, T > * RedBlackTree< Key, T, Compare >::make_chain(InputIt first, InputIt last, size_t & count)
+  {
+    detail::TreeNode< Key, T > * chain = nullptr;
+    detail::TreeNode< Key, T > ** tail = std::addressof(chain);
+    count = 0;
+    try
+    {
+      while (first != last)
+      {
+        *tail = new detail::TreeNode< Key, T >(nullptr, nullptr, nullptr, *(first++));
+        tail = std::addressof((*tail)->right);
+        ++count;
+      }
+    }
+    catch (...)
+    {
+      clear_chain(chain);
+      throw;
+    }
+    return chain;
+  }
+
+  template< class Key, class T, class Compare >
+  void RedBlackTree< Key, T, Compare >::clear_chain(detail::TreeNode< Key, T > * chain)
+  {
+    while (chain)
+    {
+      detail::TreeNode< Key, T > * next = chain->right;
+      delete chain;
+      chain = next;
+    }
+  }
+
+  template< class Key, class T, class Compare >
+  void RedBlackTree< Key, T, Compare >::flatten(detail::TreeNode< Key, T > * subtree, detail::TreeNode< Key, T > *& chain)
+  {
+    if (!subtree)
+    {
+      return;
+    }
+    flatten(subtree->right, chain);
+    detail::TreeNode< Key, T > * left = subtree->left;
+    subtree->right = chain;
+    chain = subtree;
+    flatten(left, chain);
+  }
+
+  template< class Key, class T, class Compare >
+  void RedBlackTree< Key, T, Compare >::build_from_chain(detail::TreeNode< Key, T > * chain, size_t count)
+  {
+    size_t red_depth = 0;
+    while ((size_t(2) << red_depth) <= count)
+    {
+      ++red_depth;
+    }
+    root_ = link_chain(chain, count, 0, red_depth);
+    size_ = count;
+    if (root_)
+    {
+      root_->parent = nullptr;
+      root_->color = detail::BLACK;
+    }
+  }
+
+  template< class Key, class T, class Compare >
+  detail::TreeNode< Key, T > * RedBlackTree< Key, T, Compare >::link_chain(detail::TreeNode< Key, T > *& chain, size_t count, size_t depth, size_t red_depth)
+  {
+    if (!count)
+    {
+      return nullptr;
+    }
+    size_t left_count = (count - 1) / 2;
+    detail::TreeNode< Key, T > * left = link_chain(chain, left_count, depth + 1, red_depth);
+    detail::TreeNode< Key, T > * node = chain;
+    chain = chain->right;
+    node->left = left;
+    if (left)
+    {
+      left->parent = node;
+    }
+    node->right = link_chain(chain, count - 1 - left_count, depth + 1, red_depth);
+    if (node->right)
+    {
+      node->right->parent = node;
+    }
+    node->color = (depth == red_depth) ? detail::RED : detail::BLACK;
+    return node;
+  }
+
   template< class Key, class T, class Compare >
   detail::TreeNode< Key, T > * RedBlackTree< Key, T, Compare >::find_to_change_erased(detail::TreeNode< Key, T > * subtree)
   {
@@ -953,7 +1392,7 @@ namespace erohin
     {
       return nullptr;
     }
-    if (node->parent == node->left)
+    if (node->left == subtree->parent)
     {
       return node->right;
     }
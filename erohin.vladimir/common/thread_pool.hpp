@@ -0,0 +1,182 @@
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include "dynamic_array.hpp"
+#include "stack.hpp"
+
+namespace erohin
+{
+  class ThreadPool
+  {
+  public:
+    explicit ThreadPool(size_t threads_count = std::thread::hardware_concurrency());
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool & operator=(const ThreadPool &) = delete;
+    ~ThreadPool();
+    size_t size() const noexcept;
+    template< class F1, class F2 >
+    void invoke(F1 && first, F2 && second);
+  private:
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    Stack< std::function< void() > > tasks_;
+    DynamicArray< std::thread > workers_;
+    bool stop_;
+    void stop() noexcept;
+    void work();
+    bool run_pending();
+  };
+
+  inline ThreadPool::ThreadPool(size_t threads_count):
+    stop_(false)
+  {
+    try
+    {
+      for (size_t i = 1; i < threads_count; ++i)
+      {
+        workers_.push_back(std::thread(&ThreadPool::work, this));
+      }
+    }
+    catch (...)
+    {
+      stop();
+      throw;
+    }
+  }
+
+  inline ThreadPool::~ThreadPool()
+  {
+    stop();
+  }
+
+  inline size_t ThreadPool::size() const noexcept
+  {
+    return workers_.size();
+  }
+
+  template< class F1, class F2 >
+  void ThreadPool::invoke(F1 && first, F2 && second)
+  {
+    std::atomic< bool > is_done(false);
+    std::exception_ptr second_error;
+    auto task = [&]()
+    {
+      try
+      {
+        second();
+      }
+      catch (...)
+      {
+        second_error = std::current_exception();
+      }
+      is_done.store(true, std::memory_order_release);
+    };
+    bool is_submitted = false;
+    if (size())
+    {
+      try
+      {
+        std::lock_guard< std::mutex > lock(mutex_);
+        tasks_.push(std::function< void() >(task));
+        is_submitted = true;
+      }
+      catch (...)
+      {}
+    }
+    if (is_submitted)
+    {
+      cv_.notify_one();
+    }
+    std::exception_ptr first_error;
+    try
+    {
+      first();
+    }
+    catch (...)
+    {
+      first_error = std::current_exception();
+    }
+    if (!is_submitted)
+    {
+      task();
+    }
+    while (!is_done.load(std::memory_order_acquire))
+    {
+      if (!run_pending())
+      {
+        std::this_thread::yield();
+      }
+    }
+    if (first_error)
+    {
+      std::rethrow_exception(first_error);
+    }
+    if (second_error)
+    {
+      std::rethrow_exception(second_error);
+    }
+  }
+
+  inline void ThreadPool::stop() noexcept
+  {
+    {
+      std::lock_guard< std::mutex > lock(mutex_);
+      stop_ = true;
+    }
+    cv_.notify_all();
+    for (size_t i = 0; i < workers_.size(); ++i)
+    {
+      if (workers_[i].joinable())
+      {
+        workers_[i].join();
+      }
+    }
+  }
+
+  inline void ThreadPool::work()
+  {
+    while (true)
+    {
+      std::function< void() > task;
+      {
+        std::unique_lock< std::mutex > lock(mutex_);
+        cv_.wait(lock, [this]()
+        {
+          return stop_ || !tasks_.empty();
+        });
+        if (tasks_.empty())
+        {
+          return;
+        }
+        task = std::move(tasks_.top());
+        tasks_.pop();
+      }
+      task();
+    }
+  }
+
+  inline bool ThreadPool::run_pending()
+  {
+    std::function< void() > task;
+    {
+      std::lock_guard< std::mutex > lock(mutex_);
+      if (tasks_.empty())
+      {
+        return false;
+      }
+      task = std::move(tasks_.top());
+      tasks_.pop();
+    }
+    task();
+    return true;
+  }
+}
+
+#endif
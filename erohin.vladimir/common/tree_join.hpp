@@ -0,0 +1,488 @@
+#ifndef TREE_JOIN_HPP
+#define TREE_JOIN_HPP
+
+#include <atomic>
+#include <cstddef>
+#include "tree_node.hpp"
+#include "thread_pool.hpp"
+
+namespace erohin
+{
+  namespace detail
+  {
+    // Subtree roots are detached and black, height is the black height.
+    // Compare must not throw.
+    template< class Key, class T >
+    struct Subtree
+    {
+      TreeNode< Key, T > * root;
+      size_t height;
+    };
+
+    constexpr size_t parallel_black_height = 10;
+
+    template< class Key, class T >
+    size_t black_height(const TreeNode< Key, T > * node) noexcept
+    {
+      size_t height = 0;
+      while (node)
+      {
+        if (node->color == BLACK)
+        {
+          ++height;
+        }
+        node = node->left;
+      }
+      return height;
+    }
+
+    // Stops once more than limit nodes are seen, so a result above limit
+    // only means the subtree is larger than that
+    template< class Key, class T >
+    size_t count_nodes(const TreeNode< Key, T > * node, size_t limit) noexcept
+    {
+      size_t count = 0;
+      while (node && count <= limit)
+      {
+        count += 1 + count_nodes(node->left, limit - count);
+        node = node->right;
+      }
+      return count;
+    }
+
+    template< class Key, class T >
+    void delete_subtree(TreeNode< Key, T > * node) noexcept
+    {
+      while (node)
+      {
+        delete_subtree(node->left);
+        TreeNode< Key, T > * right = node->right;
+        delete node;
+        node = right;
+      }
+    }
+
+    template< class Key, class T >
+    TreeNode< Key, T > * make_root(TreeNode< Key, T > * node) noexcept
+    {
+      if (node)
+      {
+        node->parent = nullptr;
+        node->color = BLACK;
+      }
+      return node;
+    }
+
+    template< class Key, class T >
+    void set_children(TreeNode< Key, T > * node, TreeNode< Key, T > * left, TreeNode< Key, T > * right) noexcept
+    {
+      node->left = left;
+      node->right = right;
+      if (left)
+      {
+        left->parent = node;
+      }
+      if (right)
+      {
+        right->parent = node;
+      }
+    }
+
+    template< class Key, class T >
+    void replace_child(TreeNode< Key, T > * parent, TreeNode< Key, T > * from, TreeNode< Key, T > * to) noexcept
+    {
+      to->parent = parent;
+      if (parent)
+      {
+        if (parent->left == from)
+        {
+          parent->left = to;
+        }
+        else
+        {
+          parent->right = to;
+        }
+      }
+    }
+
+    template< class Key, class T >
+    TreeNode< Key, T > * rotate_subtree_left(TreeNode< Key, T > * node) noexcept
+    {
+      TreeNode< Key, T > * top = node->right;
+      replace_child(node->parent, node, top);
+      node->right = top->left;
+      if (top->left)
+      {
+        top->left->parent = node;
+      }
+      top->left = node;
+      node->parent = top;
+      return top;
+    }
+
+    template< class Key, class T >
+    TreeNode< Key, T > * rotate_subtree_right(TreeNode< Key, T > * node) noexcept
+    {
+      TreeNode< Key, T > * top = node->left;
+      replace_child(node->parent, node, top);
+      node->left = top->right;
+      if (top->right)
+      {
+        top->right->parent = node;
+      }
+      top->right = node;
+      node->parent = top;
+      return top;
+    }
+
+    template< class Key, class T >
+    Subtree< Key, T > make_subtree(TreeNode< Key, T > * node) noexcept
+    {
+      make_root(node);
+      return Subtree< Key, T >{ node, black_height(node) };
+    }
+
+    template< class Key, class T >
+    Subtree< Key, T > child_subtree(TreeNode< Key, T > * child, size_t parent_height) noexcept
+    {
+      size_t height = parent_height - 1;
+      if (child && child->color == RED)
+      {
+        ++height;
+      }
+      return Subtree< Key, T >{ make_root(child), height };
+    }
+
+    template< class Key, class T >
+    TreeNode< Key, T > * repair_red_red(TreeNode< Key, T > * node, TreeNode< Key, T > * root) noexcept
+    {
+      while (node->parent && node->parent->color == RED)
+      {
+        TreeNode< Key, T > * parent = node->parent;
+        TreeNode< Key, T > * grand = parent->parent;
+        TreeNode< Key, T > * uncle = (grand->left == parent) ? grand->right : grand->left;
+        if (uncle && uncle->color == RED)
+        {
+          parent->color = BLACK;
+          uncle->color = BLACK;
+          grand->color = RED;
+          node = grand;
+          continue;
+        }
+        if (grand->left == parent && parent->right == node)
+        {
+          parent = rotate_subtree_left(parent);
+        }
+        else if (grand->right == parent && parent->left == node)
+        {
+          parent = rotate_subtree_right(parent);
+        }
+        parent->color = BLACK;
+        grand->color = RED;
+        TreeNode< Key, T > * top = (grand->left == parent) ? rotate_subtree_right(grand) : rotate_subtree_left(grand);
+        if (!top->parent)
+        {
+          root = top;
+        }
+        break;
+      }
+      return root;
+    }
+
+    // Links left < middle < right in O(|left.height - right.height| + 1)
+    template< class Key, class T >
+    Subtree< Key, T > join(Subtree< Key, T > left, TreeNode< Key, T > * middle, Subtree< Key, T > right) noexcept
+    {
+      middle->parent = nullptr;
+      if (left.height == right.height)
+      {
+        set_children(middle, left.root, right.root);
+        middle->color = BLACK;
+        return Subtree< Key, T >{ middle, left.height + 1 };
+      }
+      bool is_left_higher = left.height > right.height;
+      Subtree< Key, T > higher = is_left_higher ? left : right;
+      size_t target = is_left_higher ? right.height : left.height;
+      size_t height = higher.height;
+      TreeNode< Key, T > * parent = nullptr;
+      TreeNode< Key, T > * node = higher.root;
+      while (height != target || (node && node->color == RED))
+      {
+        if (node->color == BLACK)
+        {
+          --height;
+        }
+        parent = node;
+        node = is_left_higher ? node->right : node->left;
+      }
+      middle->color = RED;
+      middle->parent = parent;
+      if (is_left_higher)
+      {
+        set_children(middle, node, right.root);
+        parent->right = middle;
+      }
+      else
+      {
+        set_children(middle, left.root, node);
+        parent->left = middle;
+      }
+      TreeNode< Key, T > * root = repair_red_red(middle, higher.root);
+      if (root->color == RED)
+      {
+        ++higher.height;
+      }
+      higher.root = make_root(root);
+      return higher;
+    }
+
+    // Splits tree into keys less than key and keys greater than key,
+    // returns the detached node equal to key if there is one
+    template< class Key, class T, class Compare >
+    TreeNode< Key, T > * split(Subtree< Key, T > tree, const Key & key, const Compare & cmp,
+      Subtree< Key, T > & left, Subtree< Key, T > & right) noexcept
+    {
+      TreeNode< Key, T > * node = tree.root;
+      if (!node)
+      {
+        left = tree;
+        right = tree;
+        return nullptr;
+      }
+      Subtree< Key, T > lower = child_subtree(node->left, tree.height);
+      Subtree< Key, T > upper = child_subtree(node->right, tree.height);
+      node->left = nullptr;
+      node->right = nullptr;
+      if (cmp(key, node->data.first))
+      {
+        TreeNode< Key, T > * found = split(lower, key, cmp, left, right);
+        right = join(right, node, upper);
+        return found;
+      }
+      else if (cmp(node->data.first, key))
+      {
+        TreeNode< Key, T > * found = split(upper, key, cmp, left, right);
+        left = join(lower, node, left);
+        return found;
+      }
+      left = lower;
+      right = upper;
+      return node;
+    }
+
+    template< class Key, class T >
+    TreeNode< Key, T > * split_last(Subtree< Key, T > tree, Subtree< Key, T > & rest) noexcept
+    {
+      TreeNode< Key, T > * node = tree.root;
+      Subtree< Key, T > lower = child_subtree(node->left, tree.height);
+      Subtree< Key, T > upper = child_subtree(node->right, tree.height);
+      node->left = nullptr;
+      node->right = nullptr;
+      if (!upper.root)
+      {
+        rest = lower;
+        return node;
+      }
+      TreeNode< Key, T > * last = split_last(upper, rest);
+      rest = join(lower, node, rest);
+      return last;
+    }
+
+    template< class Key, class T >
+    Subtree< Key, T > join(Subtree< Key, T > left, Subtree< Key, T > right) noexcept
+    {
+      if (!left.root)
+      {
+        return right;
+      }
+      Subtree< Key, T > rest = left;
+      TreeNode< Key, T > * last = split_last(left, rest);
+      return join(rest, last, right);
+    }
+
+    template< class Key, class T >
+    TreeNode< Key, T > * copy_subtree(const TreeNode< Key, T > * node, size_t & count)
+    {
+      if (!node)
+      {
+        return nullptr;
+      }
+      TreeNode< Key, T > * copy = new TreeNode< Key, T >(nullptr, nullptr, nullptr, node->data);
+      copy->color = node->color;
+      try
+      {
+        copy->left = copy_subtree(node->left, count);
+        copy->right = copy_subtree(node->right, count);
+      }
+      catch (...)
+      {
+        delete_subtree(copy);
+        throw;
+      }
+      set_children(copy, copy->left, copy->right);
+      ++count;
+      return copy;
+    }
+
+    // The set operations below consume tree, only read other (whose black
+    // height is other_height) and keep the elements of tree on equal keys.
+    // Halves of a large other touch disjoint parts of tree, so when a pool
+    // is given they are processed in parallel; a null pool runs sequentially.
+
+    template< class Key, class T >
+    bool is_parallel(const TreeNode< Key, T > * other, size_t other_height, const ThreadPool * pool) noexcept
+    {
+      return other && pool && pool->size() && other_height >= parallel_black_height;
+    }
+
+    template< class Key, class T >
+    size_t child_height(const TreeNode< Key, T > * other, size_t other_height) noexcept
+    {
+      return (other->color == BLACK) ? other_height - 1 : other_height;
+    }
+
+    template< class Key, class T, class Compare >
+    Subtree< Key, T > unite(Subtree< Key, T > tree, const TreeNode< Key, T > * other, size_t other_height,
+      const Compare & cmp, ThreadPool * pool, std::atomic< size_t > & added)
+    {
+      if (!other)
+      {
+        return tree;
+      }
+      if (!tree.root)
+      {
+        size_t count = 0;
+        Subtree< Key, T > copy = make_subtree(copy_subtree(other, count));
+        added += count;
+        return copy;
+      }
+      Subtree< Key, T > lower = tree;
+      Subtree< Key, T > upper = tree;
+      TreeNode< Key, T > * middle = split(tree, other->data.first, cmp, lower, upper);
+      if (!middle)
+      {
+        try
+        {
+          middle = new TreeNode< Key, T >(nullptr, nullptr, nullptr, other->data);
+        }
+        catch (...)
+        {
+          delete_subtree(lower.root);
+          delete_subtree(upper.root);
+          throw;
+        }
+        ++added;
+      }
+      size_t height = child_height(other, other_height);
+      auto unite_lower = [&]()
+      {
+        Subtree< Key, T > piece = lower;
+        lower.root = nullptr;
+        lower = unite(piece, other->left, height, cmp, pool, added);
+      };
+      auto unite_upper = [&]()
+      {
+        Subtree< Key, T > piece = upper;
+        upper.root = nullptr;
+        upper = unite(piece, other->right, height, cmp, pool, added);
+      };
+      try
+      {
+        if (is_parallel(other, other_height, pool))
+        {
+          pool->invoke(unite_lower, unite_upper);
+        }
+        else
+        {
+          unite_lower();
+          unite_upper();
+        }
+      }
+      catch (...)
+      {
+        delete_subtree(lower.root);
+        delete_subtree(upper.root);
+        delete middle;
+        throw;
+      }
+      return join(lower, middle, upper);
+    }
+
+    template< class Key, class T, class Compare >
+    Subtree< Key, T > intersect(Subtree< Key, T > tree, const TreeNode< Key, T > * other, size_t other_height,
+      const Compare & cmp, ThreadPool * pool, std::atomic< size_t > & kept)
+    {
+      if (!tree.root || !other)
+      {
+        delete_subtree(tree.root);
+        return Subtree< Key, T >{ nullptr, 0 };
+      }
+      Subtree< Key, T > lower = tree;
+      Subtree< Key, T > upper = tree;
+      TreeNode< Key, T > * middle = split(tree, other->data.first, cmp, lower, upper);
+      size_t height = child_height(other, other_height);
+      auto intersect_lower = [&]()
+      {
+        lower = intersect(lower, other->left, height, cmp, pool, kept);
+      };
+      auto intersect_upper = [&]()
+      {
+        upper = intersect(upper, other->right, height, cmp, pool, kept);
+      };
+      if (lower.root && upper.root && is_parallel(other, other_height, pool))
+      {
+        pool->invoke(intersect_lower, intersect_upper);
+      }
+      else
+      {
+        intersect_lower();
+        intersect_upper();
+      }
+      if (!middle)
+      {
+        return join(lower, upper);
+      }
+      ++kept;
+      return join(lower, middle, upper);
+    }
+
+    template< class Key, class T, class Compare >
+    Subtree< Key, T > subtract(Subtree< Key, T > tree, const TreeNode< Key, T > * other, size_t other_height,
+      const Compare & cmp, ThreadPool * pool, std::atomic< size_t > & removed)
+    {
+      if (!tree.root || !other)
+      {
+        return tree;
+      }
+      Subtree< Key, T > lower = tree;
+      Subtree< Key, T > upper = tree;
+      TreeNode< Key, T > * middle = split(tree, other->data.first, cmp, lower, upper);
+      if (middle)
+      {
+        delete middle;
+        ++removed;
+      }
+      size_t height = child_height(other, other_height);
+      auto subtract_lower = [&]()
+      {
+        lower = subtract(lower, other->left, height, cmp, pool, removed);
+      };
+      auto subtract_upper = [&]()
+      {
+        upper = subtract(upper, other->right, height, cmp, pool, removed);
+      };
+      if (lower.root && upper.root && is_parallel(other, other_height, pool))
+      {
+        pool->invoke(subtract_lower, subtract_upper);
+      }
+      else
+      {
+        subtract_lower();
+        subtract_upper();
+      }
+      return join(lower, upper);
+    }
+  }
+}
+
+#endif
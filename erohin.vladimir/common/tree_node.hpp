@@ -27,6 +27,8 @@ namespace erohin
       ~TreeNode() = default;
       TreeNode * next();
       TreeNode * prev();
+      const TreeNode * next() const;
+      const TreeNode * prev() const;
     };
 
     template< class Key, class T >
@@ -53,22 +55,11 @@ namespace erohin
       }
       else
       {
-        if (!parent)
-        {
-          return nullptr;
-        }
-        while (node->parent->right == node)
-        {
-          node = node->parent;
-          if (!node->parent)
-          {
-            return nullptr;
-          }
-        }
-        while (node->parent && node->parent->left == node)
+        while (node->parent && node->parent->right == node)
         {
           node = node->parent;
         }
+        node = node->parent;
       }
       return node;
     }
@@ -87,21 +78,26 @@ namespace erohin
       }
       else
       {
-        while (node->parent->left == node)
-        {
-          node = node->parent;
-          if (!(node->parent))
-          {
-            return nullptr;
-          }
-        }
-        while (node->parent && node->parent->right == node)
+        while (node->parent && node->parent->left == node)
         {
           node = node->parent;
         }
+        node = node->parent;
       }
       return node;
     }
+
+    template< class Key, class T >
+    const TreeNode< Key, T > * TreeNode< Key, T >::next() const
+    {
+      return const_cast< TreeNode< Key, T > * >(this)->next();
+    }
+
+    template< class Key, class T >
+    const TreeNode< Key, T > * TreeNode< Key, T >::prev() const
+    {
+      return const_cast< TreeNode< Key, T > * >(this)->prev();
+    }
   }
 }
 
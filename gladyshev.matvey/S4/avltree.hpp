@@ -24,15 +24,31 @@ namespace gladyshev
     }
     size_t size() const noexcept
     {
-      if (!root_)
+      return size(root_);
+    }
+    size_t count(const Key& key) const
+    {
+      return find(key) != cend();
+    }
+    size_t count_range(const Key& lo, const Key& hi) const
+    {
+      if (Compare()(hi, lo))
       {
         return 0;
       }
-      return 1 + size(root_->right) + size(root_->left);
+      return countLess(hi, true) - countLess(lo, false);
     }
-    size_t count(const Key& key) const
+    size_t rank(const Key& key) const
     {
-      return find(key) != cend();
+      return countLess(key, false);
+    }
+    citer select(size_t k) const
+    {
+      return citer(selectNode(k));
+    }
+    iter select(size_t k)
+    {
+      return iter(selectNode(k));
     }
     citer cbegin() const noexcept
     {
@@ -105,6 +121,7 @@ namespace gladyshev
           return root_->data.second;
         }
         std::pair< tnode*, tnode* > result = insertImpl(key, Value(), root_);
+        root_ = result.first;
         node = result.second;
       }
       return node->data.second;
@@ -152,6 +169,7 @@ namespace gladyshev
     void clear()
     {
       helpClear(root_);
+      root_ = nullptr;
     }
     Tree& operator=(const Tree& other)
     {
@@ -181,10 +199,14 @@ namespace gladyshev
       tnode* temp = toRotate->right;
       toRotate->right = node;
       node->left = temp;
+      if (temp)
+      {
+        temp->parent = node;
+      }
       toRotate->parent = node->parent;
       node->parent = toRotate;
-      node->height = std::max(height(node->left), height(node->right)) + 1;
-      toRotate->height = std::max(height(toRotate->left), height(toRotate->right)) + 1;
+      update(node);
+      update(toRotate);
       return toRotate;
     }
     tnode* rotateLeft(tnode* node)
@@ -193,10 +215,14 @@ namespace gladyshev
       tnode* temp = toRotate->left;
       toRotate->left = node;
       node->right = temp;
+      if (temp)
+      {
+        temp->parent = node;
+      }
       toRotate->parent = node->parent;
       node->parent = toRotate;
-      node->height = std::max(height(node->left), height(node->right)) + 1;
-      toRotate->height = std::max(height(toRotate->left), height(toRotate->right)) + 1;
+      update(node);
+      update(toRotate);
       return toRotate;
     }
     tnode* copyNodes(tnode* node, tnode* parent)
@@ -210,6 +236,7 @@ namespace gladyshev
       newNode->left = copyNodes(node->left, newNode);
       newNode->right = copyNodes(node->right, newNode);
       newNode->height = node->height;
+      newNode->size = node->size;
       return newNode;
     }
     tnode* eraseImpl(tnode* t, const Key& key)
@@ -231,6 +258,10 @@ namespace gladyshev
         if (!t->left || !t->right)
         {
           tnode* temp = t->left ? t->left : t->right;
+          if (temp)
+          {
+            temp->parent = t->parent;
+          }
           delete t;
           return temp;
         }
@@ -245,7 +276,7 @@ namespace gladyshev
           t->left = eraseImpl(t->left, m->data.first);
        }
       }
-      t->height = 1 + std::max(height(t->left), height(t->right));
+      update(t);
       return rebalance(t);
     }
     tnode* rebalance(tnode* node)
@@ -292,7 +323,7 @@ namespace gladyshev
         {
           auto result = insertImpl(key, value, node->left);
           node->left = result.first;
-          temp = node->left;
+          temp = result.second;
         }
       }
       else if (Compare()(node->data.first, key))
@@ -315,8 +346,8 @@ namespace gladyshev
         node->data.second = value;
         temp = node;
       }
+      update(node);
       node = rebalance(node);
-      node->height = 1 + std::max(height(node->left), height(node->right));
       return std::make_pair(node, temp);
     }
     tnode* findNode(tnode* node, const Key& key) const
@@ -347,7 +378,7 @@ namespace gladyshev
         delete node;
       }
     }
-    long long height(tnode* node)
+    long long height(const tnode* node) const noexcept
     {
       if (!node)
       {
@@ -355,6 +386,59 @@ namespace gladyshev
       }
       return node->height;
     }
+    size_t size(const tnode* node) const noexcept
+    {
+      if (!node)
+      {
+        return 0;
+      }
+      return node->size;
+    }
+    void update(tnode* node) noexcept
+    {
+      node->height = 1 + std::max(height(node->left), height(node->right));
+      node->size = 1 + size(node->left) + size(node->right);
+    }
+    size_t countLess(const Key& key, bool inclusive) const
+    {
+      size_t result = 0;
+      tnode* node = root_;
+      while (node)
+      {
+        if (Compare()(node->data.first, key) || (inclusive && !Compare()(key, node->data.first)))
+        {
+          result += size(node->left) + 1;
+          node = node->right;
+        }
+        else
+        {
+          node = node->left;
+        }
+      }
+      return result;
+    }
+    tnode* selectNode(size_t k) const
+    {
+      tnode* node = root_;
+      while (node)
+      {
+        size_t leftSize = size(node->left);
+        if (k < leftSize)
+        {
+          node = node->left;
+        }
+        else if (k == leftSize)
+        {
+          return node;
+        }
+        else
+        {
+          k -= leftSize + 1;
+          node = node->right;
+        }
+      }
+      return nullptr;
+    }
     tnode* root_;
   };
 }
@@ -0,0 +1,136 @@
+#define BOOST_TEST_MODULE S4
+#include <boost/test/included/unit_test.hpp>
+
+#include <iterator>
+#include <map>
+#include <random>
+#include <string>
+
+#include "avltree.hpp"
+
+namespace
+{
+  using tree_t = gladyshev::Tree< int, std::string >;
+  using model_t = std::map< int, std::string >;
+
+  void checkOrderStatistics(const tree_t& tree, const model_t& model)
+  {
+    BOOST_REQUIRE_EQUAL(tree.size(), model.size());
+    size_t k = 0;
+    for (auto it = model.cbegin(); it != model.cend(); ++it, ++k)
+    {
+      auto selected = tree.select(k);
+      BOOST_REQUIRE(selected != tree.cend());
+      BOOST_REQUIRE_EQUAL(selected->first, it->first);
+      BOOST_REQUIRE_EQUAL(tree.rank(it->first), k);
+    }
+    BOOST_CHECK(tree.select(model.size()) == tree.cend());
+  }
+
+  void checkRanges(const tree_t& tree, const model_t& model, std::mt19937& gen, int maxKey)
+  {
+    std::uniform_int_distribution< int > keys(-2, maxKey + 2);
+    for (int i = 0; i < 50; ++i)
+    {
+      int lo = keys(gen);
+      int hi = keys(gen);
+      size_t expected = 0;
+      if (lo <= hi)
+      {
+        expected = std::distance(model.lower_bound(lo), model.upper_bound(hi));
+      }
+      BOOST_REQUIRE_EQUAL(tree.count_range(lo, hi), expected);
+      BOOST_REQUIRE_EQUAL(tree.rank(lo), static_cast< size_t >(std::distance(model.cbegin(), model.lower_bound(lo))));
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(empty_tree)
+{
+  const tree_t tree;
+  BOOST_CHECK_EQUAL(tree.size(), 0);
+  BOOST_CHECK_EQUAL(tree.count_range(0, 10), 0);
+  BOOST_CHECK_EQUAL(tree.rank(5), 0);
+  BOOST_CHECK(tree.select(0) == tree.cend());
+}
+
+BOOST_AUTO_TEST_CASE(reversed_range)
+{
+  tree_t tree;
+  for (int i = 0; i < 10; ++i)
+  {
+    tree.insert(i, "");
+  }
+  BOOST_CHECK_EQUAL(tree.count_range(7, 3), 0);
+  BOOST_CHECK_EQUAL(tree.count_range(3, 3), 1);
+  BOOST_CHECK_EQUAL(tree.count_range(3, 7), 5);
+}
+
+BOOST_AUTO_TEST_CASE(out_of_range_queries)
+{
+  tree_t tree;
+  for (int i = 10; i <= 50; i += 10)
+  {
+    tree.insert(i, "");
+  }
+  const tree_t& ctree = tree;
+  BOOST_CHECK(ctree.select(5) == ctree.cend());
+  BOOST_CHECK(ctree.select(100) == ctree.cend());
+  BOOST_CHECK(tree.select(5) == tree.end());
+  BOOST_CHECK_EQUAL(ctree.rank(5), 0);
+  BOOST_CHECK_EQUAL(ctree.rank(10), 0);
+  BOOST_CHECK_EQUAL(ctree.rank(25), 2);
+  BOOST_CHECK_EQUAL(ctree.rank(50), 4);
+  BOOST_CHECK_EQUAL(ctree.rank(60), 5);
+  BOOST_CHECK_EQUAL(ctree.count_range(51, 100), 0);
+  BOOST_CHECK_EQUAL(ctree.count_range(0, 9), 0);
+  BOOST_CHECK_EQUAL(ctree.count_range(0, 100), 5);
+}
+
+BOOST_AUTO_TEST_CASE(random_insert_erase_matches_model)
+{
+  const int maxKey = 300;
+  std::mt19937 gen(20240501);
+  std::uniform_int_distribution< int > keys(0, maxKey);
+  std::uniform_int_distribution< int > coin(0, 2);
+  tree_t tree;
+  model_t model;
+  for (int step = 0; step < 4000; ++step)
+  {
+    int key = keys(gen);
+    if (coin(gen) == 0)
+    {
+      tree.erase(key);
+      model.erase(key);
+    }
+    else
+    {
+      tree.insert(key, std::to_string(key));
+      model.insert(std::make_pair(key, std::to_string(key)));
+    }
+    if (step % 100 == 0)
+    {
+      checkOrderStatistics(tree, model);
+      checkRanges(tree, model, gen, maxKey);
+    }
+  }
+  checkOrderStatistics(tree, model);
+  checkRanges(tree, model, gen, maxKey);
+}
+
+BOOST_AUTO_TEST_CASE(copy_keeps_sizes)
+{
+  std::mt19937 gen(7);
+  std::uniform_int_distribution< int > keys(0, 1000);
+  tree_t tree;
+  model_t model;
+  for (int i = 0; i < 500; ++i)
+  {
+    int key = keys(gen);
+    tree.insert(key, "");
+    model.insert(std::make_pair(key, ""));
+  }
+  tree_t copy(tree);
+  checkOrderStatistics(copy, model);
+  checkRanges(copy, model, gen, 1000);
+}
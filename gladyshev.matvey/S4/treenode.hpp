@@ -1,6 +1,7 @@
 #ifndef TREENODE_HPP
 #define TREENODE_HPP
 
+#include <cstddef>
 #include <utility>
 
 namespace gladyshev
@@ -15,12 +16,14 @@ namespace gladyshev
       TNode* left;
       TNode* parent;
       long long height;
+      size_t size;
       TNode(const Key& key, const Value& value):
         data(std::make_pair(key, value)),
         right(nullptr),
         left(nullptr),
         parent(nullptr),
-        height(0)
+        height(1),
+        size(1)
       {}
     };
   }
@@ -1,10 +1,103 @@
 #include "commands.hpp"
+#include <memory>
+#include <utility>
+
+namespace
+{
+  using dict_t = namestnikov::Tree< size_t, std::string >;
+  using dict_pair_t = std::pair< size_t, std::string >;
+
+  class MergeCursor
+  {
+  public:
+    MergeCursor(const dict_t & left, const dict_t & right, bool keepLeft, bool keepBoth, bool keepRight):
+      left_(left.cbegin()),
+      leftEnd_(left.cend()),
+      right_(right.cbegin()),
+      rightEnd_(right.cend()),
+      keepLeft_(keepLeft),
+      keepBoth_(keepBoth),
+      keepRight_(keepRight)
+    {}
+    const dict_pair_t * next()
+    {
+      while ((left_ != leftEnd_) || (right_ != rightEnd_))
+      {
+        if ((right_ == rightEnd_) || ((left_ != leftEnd_) && (left_->first < right_->first)))
+        {
+          const dict_pair_t * current = std::addressof(*(left_++));
+          if (keepLeft_)
+          {
+            return current;
+          }
+        }
+        else if ((left_ == leftEnd_) || (right_->first < left_->first))
+        {
+          const dict_pair_t * current = std::addressof(*(right_++));
+          if (keepRight_)
+          {
+            return current;
+          }
+        }
+        else
+        {
+          const dict_pair_t * current = std::addressof(*(left_++));
+          ++right_;
+          if (keepBoth_)
+          {
+            return current;
+          }
+        }
+      }
+      return nullptr;
+    }
+  private:
+    dict_t::const_iterator left_;
+    dict_t::const_iterator leftEnd_;
+    dict_t::const_iterator right_;
+    dict_t::const_iterator rightEnd_;
+    bool keepLeft_;
+    bool keepBoth_;
+    bool keepRight_;
+  };
+
+  dict_t mergeDicts(const dict_t & left, const dict_t & right, bool keepLeft, bool keepBoth, bool keepRight)
+  {
+    size_t count = 0;
+    MergeCursor counter(left, right, keepLeft, keepBoth, keepRight);
+    while (counter.next())
+    {
+      ++count;
+    }
+    MergeCursor cursor(left, right, keepLeft, keepBoth, keepRight);
+    dict_t res;
+    res.build_sorted(count, [&cursor]() -> const dict_pair_t &
+    {
+      return *cursor.next();
+    });
+    return res;
+  }
+
+  void makeSetOperation(std::istream & in, namestnikov::Tree< std::string, dict_t > & myMap, bool keepLeft, bool keepBoth, bool keepRight)
+  {
+    std::string newName = "";
+    in >> newName;
+    std::string firstName = "";
+    in >> firstName;
+    std::string secondName = "";
+    in >> secondName;
+    const dict_t & left = myMap.at(firstName);
+    const dict_t & right = myMap.at(secondName);
+    dict_t res = mergeDicts(left, right, keepLeft, keepBoth, keepRight);
+    myMap[newName] = std::move(res);
+  }
+}
 
 void namestnikov::print(std::istream & in, Tree< std::string, Tree< size_t, std::string > > & myMap, std::ostream & out)
 {
   std::string name = "";
   in >> name;
-  Tree< size_t, std::string > map = myMap.at(name);
+  const Tree< size_t, std::string > & map = myMap.at(name);
   if (map.empty())
   {
     out << "<EMPTY>\n";
@@ -22,70 +115,15 @@ void namestnikov::print(std::istream & in, Tree< std::string, Tree< size_t, std:
 
 void namestnikov::makeIntersect(std::istream & in, Tree< std::string, Tree< size_t, std::string > > & myMap)
 {
-  std::string newName = "";
-  in >> newName;
-  std::string firstName = "";
-  in >> firstName;
-  std::string secondName = "";
-  in >> secondName;
-  Tree< size_t, std::string > res;
-  Tree< size_t, std::string > left = myMap.at(firstName);
-  Tree< size_t, std::string > right = myMap.at(secondName);
-  for (const auto & key1: left)
-  {
-    for (const auto & key2: right)
-    {
-      if (key1.first == key2.first)
-      {
-        res.insert(key1.first, key1.second);
-      }
-    }
-  }
-  myMap[newName] = res;
+  makeSetOperation(in, myMap, false, true, false);
 }
 
 void namestnikov::makeUnion(std::istream & in, Tree< std::string, Tree< size_t, std::string > > & myMap)
 {
-  std::string newName = "";
-  in >> newName;
-  std::string firstName = "";
-  in >> firstName;
-  std::string secondName = "";
-  in >> secondName;
-  Tree< size_t, std::string > res;
-  Tree< size_t, std::string > left = myMap.at(firstName);
-  Tree< size_t, std::string > right = myMap.at(secondName);
-  for (const auto & key1: left)
-  {
-    res.insert(key1.first, key1.second);
-  }
-  for (const auto & key2: right)
-  {
-    if (res.find(key2.first) == res.cend())
-    {
-      res.insert(key2.first, key2.second);
-    }
-  }
-  myMap[newName] = res;
+  makeSetOperation(in, myMap, true, true, true);
 }
 
 void namestnikov::makeComplement(std::istream & in, Tree< std::string, Tree< size_t, std::string > > & myMap)
 {
-  std::string newName = "";
-  in >> newName;
-  std::string firstName = "";
-  in >> firstName;
-  std::string secondName = "";
-  in >> secondName;
-  Tree< size_t, std::string > res;
-  Tree< size_t, std::string > left = myMap.at(firstName);
-  Tree< size_t, std::string > right = myMap.at(secondName);
-  for (const auto & key1: left)
-  {
-    if (right.find(key1.first) == right.cend())
-    {
-      res.insert(key1.first, key1.second);
-    }
-  }
-  myMap[newName] = res;
+  makeSetOperation(in, myMap, true, false, false);
 }
@@ -0,0 +1,89 @@
+#define BOOST_TEST_MODULE S5
+#include <boost/test/included/unit_test.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <stdexcept>
+#include <vector>
+#include <tree.hpp>
+
+namespace
+{
+  using tree_t = namestnikov::Tree< int, int >;
+
+  struct Collect
+  {
+    std::vector< int > keys;
+    void operator()(const std::pair< const int, int > & data)
+    {
+      keys.push_back(data.first);
+    }
+  };
+
+  std::vector< int > ascending(int count)
+  {
+    std::vector< int > keys;
+    for (int i = 0; i < count; ++i)
+    {
+      keys.push_back(i);
+    }
+    return keys;
+  }
+}
+
+BOOST_AUTO_TEST_CASE(empty_tree_throws)
+{
+  const tree_t tree;
+  BOOST_CHECK_THROW(tree.traverse_breadth(Collect()), std::logic_error);
+  BOOST_CHECK_THROW(tree.traverse_lnr(Collect()), std::logic_error);
+  BOOST_CHECK_THROW(tree.traverse_rnl(Collect()), std::logic_error);
+}
+
+BOOST_AUTO_TEST_CASE(degenerate_tree)
+{
+  // Sorted input makes a chain as deep as the tree is large
+  const int count = 5000;
+  tree_t ascendingTree;
+  tree_t descendingTree;
+  for (int i = 0; i < count; ++i)
+  {
+    ascendingTree.insert(i, i);
+    descendingTree.insert(count - 1 - i, i);
+  }
+  std::vector< int > expected = ascending(count);
+  BOOST_CHECK(ascendingTree.traverse_breadth(Collect()).keys == expected);
+  BOOST_CHECK(ascendingTree.traverse_lnr(Collect()).keys == expected);
+  std::vector< int > reversed(expected.rbegin(), expected.rend());
+  BOOST_CHECK(descendingTree.traverse_breadth(Collect()).keys == reversed);
+  BOOST_CHECK(descendingTree.traverse_rnl(Collect()).keys == reversed);
+}
+
+BOOST_AUTO_TEST_CASE(breadth_visits_levels_in_order)
+{
+  tree_t tree;
+  const int keys[] = { 50, 30, 70, 20, 40, 60, 80, 10, 45, 65 };
+  for (int key: keys)
+  {
+    tree.insert(key, key);
+  }
+  std::vector< int > expected(std::begin(keys), std::end(keys));
+  BOOST_CHECK(tree.traverse_breadth(Collect()).keys == expected);
+}
+
+BOOST_AUTO_TEST_CASE(random_tree_visits_every_key)
+{
+  std::mt19937 gen(48);
+  std::vector< int > keys = ascending(2000);
+  std::shuffle(keys.begin(), keys.end(), gen);
+  tree_t tree;
+  for (int key: keys)
+  {
+    tree.insert(key, key);
+  }
+  std::vector< int > visited = tree.traverse_breadth(Collect()).keys;
+  BOOST_REQUIRE_EQUAL(visited.size(), keys.size());
+  BOOST_CHECK_EQUAL(visited.front(), keys.front());
+  std::sort(visited.begin(), visited.end());
+  BOOST_CHECK(visited == ascending(2000));
+}
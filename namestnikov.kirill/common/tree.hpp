@@ -1,13 +1,13 @@
 #ifndef TREE_HPP
 #define TREE_HPP
 
+#include <algorithm>
 #include <functional>
 #include <type_traits>
 #include <cassert>
 #include <tree_node.hpp>
 #include <tree_iterator.hpp>
 #include <queue.hpp>
-#include <stack.hpp>
 #include <const_tree_iterator.hpp>
 
 namespace namestnikov
@@ -31,20 +31,11 @@ namespace namestnikov
       size_(0),
       compare_(other.compare_)
     {
-      try
+      const_iterator current = other.cbegin();
+      build_sorted(other.size_, [&current]() -> const std::pair< Key, Value > &
       {
-        const_iterator begin = other.cbegin();
-        const_iterator end = other.cend();
-        for (; begin != end; ++begin)
-        {
-          insert(begin->first, begin->second);
-        }
-      }
-      catch (...)
-      {
-        clear();
-        throw;
-      }
+        return *(current++);
+      });
     }
 
     Tree(Tree && other) noexcept:
@@ -105,6 +96,22 @@ namespace namestnikov
         throw;
       }
     }
+    template< class Generator >
+    void build_sorted(size_t count, Generator next)
+    {
+      clear();
+      size_ = count;
+      try
+      {
+        int depth = 0;
+        root_ = build_impl(count, next, depth);
+      }
+      catch (...)
+      {
+        size_ = 0;
+        throw;
+      }
+    }
     void balance(node_t * node)
     {
       if (node->height < 0)
@@ -253,6 +260,11 @@ namespace namestnikov
     }
     template< class F >
     F traverse_lnr(F f)
+    {
+      return static_cast< const Tree & >(*this).traverse_lnr(f);
+    }
+    template< class F >
+    F traverse_lnr(F f) const
     {
       if (empty())
       {
@@ -260,33 +272,41 @@ namespace namestnikov
       }
       else
       {
-        Stack< node_t * > traverseStack;
         node_t * current = root_;
-        while (current || (!traverseStack.empty()))
+        while (current->left)
+        {
+          current = current->left;
+        }
+        while (current)
         {
-          if (current)
+          f(current->data);
+          if (current->right)
           {
-            traverseStack.push(current);
-            current = current->left;
+            current = current->right;
+            while (current->left)
+            {
+              current = current->left;
+            }
           }
           else
           {
-            current = traverseStack.top();
-            traverseStack.pop();
-            f(current->data);
-            current = current->right;
+            while ((current != root_) && current->isRightChild())
+            {
+              current = current->parent;
+            }
+            current = (current == root_) ? nullptr : current->parent;
           }
         }
         return f;
       }
     }
     template< class F >
-    F traverse_lnr(F f) const
+    F traverse_rnl(F f)
     {
-      return static_cast< const F >(traverse_lnr(f));
+      return static_cast< const Tree & >(*this).traverse_rnl(f);
     }
     template< class F >
-    F traverse_rnl(F f)
+    F traverse_rnl(F f) const
     {
       if (empty())
       {
@@ -294,33 +314,41 @@ namespace namestnikov
       }
       else
       {
-        Stack< node_t * > traverseStack;
         node_t * current = root_;
-        while (current || (!traverseStack.empty()))
+        while (current->right)
         {
-          if (current)
+          current = current->right;
+        }
+        while (current)
+        {
+          f(current->data);
+          if (current->left)
           {
-            traverseStack.push(current);
-            current = current->right;
+            current = current->left;
+            while (current->right)
+            {
+              current = current->right;
+            }
           }
           else
           {
-            current = traverseStack.top();
-            traverseStack.pop();
-            f(current->data);
-            current = current->left;
+            while ((current != root_) && current->isLeftChild())
+            {
+              current = current->parent;
+            }
+            current = (current == root_) ? nullptr : current->parent;
           }
         }
+        return f;
       }
-      return f;
     }
     template< class F >
-    F traverse_rnl(F f) const
+    F traverse_breadth(F f)
     {
-      return static_cast< const F >(traverse_rnl(f));
+      return static_cast< const Tree & >(*this).traverse_breadth(f);
     }
     template< class F >
-    F traverse_breadth(F f)
+    F traverse_breadth(F f) const
     {
       if (empty())
       {
@@ -328,12 +356,13 @@ namespace namestnikov
       }
       else
       {
+        // Holds at most one level and part of the next, so a degenerate
+        // tree keeps a single node queued while the walk stays O(n)
         Queue< node_t * > traverseQueue;
-        node_t * current = root_;
-        traverseQueue.push(current);
+        traverseQueue.push(root_);
         while (!traverseQueue.empty())
         {
-          current = traverseQueue.front();
+          node_t * current = traverseQueue.front();
           traverseQueue.pop();
           f(current->data);
           if (current->left)
@@ -348,11 +377,6 @@ namespace namestnikov
         return f;
       }
     }
-    template< class F >
-    F traverse_breadth(F f) const
-    {
-      return static_cast< const F >(traverse_breadth(f));
-    }
     ~Tree()
     {
       clear();
@@ -384,6 +408,43 @@ namespace namestnikov
       }
       return result;
     }
+    template< class Generator >
+    node_t * build_impl(size_t count, Generator & next, int & depth)
+    {
+      if (count == 0)
+      {
+        depth = 0;
+        return nullptr;
+      }
+      size_t rightCount = (count - 1) / 2;
+      int leftDepth = 0;
+      int rightDepth = 0;
+      node_t * left = build_impl(count - 1 - rightCount, next, leftDepth);
+      node_t * node = nullptr;
+      try
+      {
+        const auto & value = next();
+        node = new node_t(value.first, value.second);
+        node->left = left;
+        node->right = build_impl(rightCount, next, rightDepth);
+      }
+      catch (...)
+      {
+        clear_impl(node ? node : left);
+        throw;
+      }
+      if (node->left)
+      {
+        node->left->parent = node;
+      }
+      if (node->right)
+      {
+        node->right->parent = node;
+      }
+      node->height = leftDepth - rightDepth;
+      depth = std::max(leftDepth, rightDepth) + 1;
+      return node;
+    }
     node_t * rotateLeft(node_t * node)
     {
       node_t * newRoot = node->right;
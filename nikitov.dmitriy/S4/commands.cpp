@@ -1,9 +1,10 @@
 #include "commands.hpp"
 #include <istream>
+#include <utility>
 
-void nikitov::printCmd(const Tree< std::string, Tree< size_t, std::string > >& tree, const std::string& dictName, std::ostream& output)
+void nikitov::printCmd(const Tree< std::string, Dictionary >& tree, const std::string& dictName, std::ostream& output)
 {
-  Tree< size_t, std::string > dict = tree.at(dictName);
+  const Tree< size_t, std::string >& dict = *tree.at(dictName);
   if (dict.empty())
   {
     throw std::logic_error("<EMPTY>");
@@ -16,12 +17,18 @@ void nikitov::printCmd(const Tree< std::string, Tree< size_t, std::string > >& t
   output << '\n';
 }
 
-void nikitov::complementCmd(Tree< std::string, Tree< size_t, std::string > >& tree, const std::string& newDictName,
+void nikitov::complementCmd(Tree< std::string, Dictionary >& tree, const std::string& newDictName,
   const std::string& firstDictName, const std::string& secondDictName)
 {
+  const Tree< size_t, std::string >& dict1 = *tree.at(firstDictName);
+  const Tree< size_t, std::string >& dict2 = *tree.at(secondDictName);
+  if (dict2.empty())
+  {
+    Dictionary shared = tree.at(firstDictName);
+    tree[newDictName] = std::move(shared);
+    return;
+  }
   Tree< size_t, std::string > newDict;
-  Tree< size_t, std::string > dict1 = tree.at(firstDictName);
-  Tree< size_t, std::string > dict2 = tree.at(secondDictName);
   for (auto i = dict1.cbegin(); i != dict1.cend(); ++i)
   {
     try
@@ -33,15 +40,21 @@ void nikitov::complementCmd(Tree< std::string, Tree< size_t, std::string > >& tr
       newDict.insert({ (*i).first, (*i).second });
     }
   }
-  tree[newDictName] = newDict;
+  tree[newDictName] = Dictionary(std::move(newDict));
 }
 
-void nikitov::intersectCmd(Tree< std::string, Tree< size_t, std::string > >& tree, const std::string& newDictName,
+void nikitov::intersectCmd(Tree< std::string, Dictionary >& tree, const std::string& newDictName,
   const std::string& firstDictName, const std::string& secondDictName)
 {
+  const Tree< size_t, std::string >& dict1 = *tree.at(firstDictName);
+  const Tree< size_t, std::string >& dict2 = *tree.at(secondDictName);
+  if (firstDictName == secondDictName)
+  {
+    Dictionary shared = tree.at(firstDictName);
+    tree[newDictName] = std::move(shared);
+    return;
+  }
   Tree< size_t, std::string > newDict;
-  Tree< size_t, std::string > dict1 = tree.at(firstDictName);
-  Tree< size_t, std::string > dict2 = tree.at(secondDictName);
   for (auto i = dict2.cbegin(); i != dict2.cend(); ++i)
   {
     try
@@ -53,15 +66,27 @@ void nikitov::intersectCmd(Tree< std::string, Tree< size_t, std::string > >& tre
       continue;
     }
   }
-  tree[newDictName] = newDict;
+  tree[newDictName] = Dictionary(std::move(newDict));
 }
 
-void nikitov::unionCmd(Tree< std::string, Tree< size_t, std::string > >& tree, const std::string& newDictName,
+void nikitov::unionCmd(Tree< std::string, Dictionary >& tree, const std::string& newDictName,
   const std::string& firstDictName, const std::string& secondDictName)
 {
+  const Tree< size_t, std::string >& dict1 = *tree.at(firstDictName);
+  const Tree< size_t, std::string >& dict2 = *tree.at(secondDictName);
+  if (dict2.empty() || firstDictName == secondDictName)
+  {
+    Dictionary shared = tree.at(firstDictName);
+    tree[newDictName] = std::move(shared);
+    return;
+  }
+  if (dict1.empty())
+  {
+    Dictionary shared = tree.at(secondDictName);
+    tree[newDictName] = std::move(shared);
+    return;
+  }
   Tree< size_t, std::string > newDict;
-  Tree< size_t, std::string > dict1 = tree.at(firstDictName);
-  Tree< size_t, std::string > dict2 = tree.at(secondDictName);
   for (auto i = dict1.cbegin(); i != dict1.cend(); ++i)
   {
     newDict.insert({(*i).first, (*i).second });
@@ -70,5 +95,5 @@ void nikitov::unionCmd(Tree< std::string, Tree< size_t, std::string > >& tree, c
   {
     newDict.insert({(*i).first, (*i).second });
   }
-  tree[newDictName] = newDict;
+  tree[newDictName] = Dictionary(std::move(newDict));
 }
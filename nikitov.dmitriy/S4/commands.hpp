@@ -3,18 +3,21 @@
 
 #include <istream>
 #include <tree.hpp>
+#include "cow_handle.hpp"
 
 namespace nikitov
 {
-  void printCmd(const Tree< std::string, Tree< size_t, std::string > >& tree, const std::string& dictName, std::ostream& output);
+  using Dictionary = CowHandle< Tree< size_t, std::string > >;
 
-  void complementCmd(Tree< std::string, Tree< size_t, std::string > >& tree, const std::string& newDictName,
+  void printCmd(const Tree< std::string, Dictionary >& tree, const std::string& dictName, std::ostream& output);
+
+  void complementCmd(Tree< std::string, Dictionary >& tree, const std::string& newDictName,
     const std::string& firstDictName, const std::string& secondDictName);
 
-  void intersectCmd(Tree< std::string, Tree< size_t, std::string > >& tree, const std::string& newDictName,
+  void intersectCmd(Tree< std::string, Dictionary >& tree, const std::string& newDictName,
     const std::string& firstDictName, const std::string& secondDictName);
 
-  void unionCmd(Tree< std::string, Tree< size_t, std::string > >& tree, const std::string& newDictName,
+  void unionCmd(Tree< std::string, Dictionary >& tree, const std::string& newDictName,
     const std::string& firstDictName, const std::string& secondDictName);
 }
 #endif
@@ -0,0 +1,78 @@
+#ifndef COW_HANDLE_HPP
+#define COW_HANDLE_HPP
+
+#include <memory>
+#include <utility>
+
+namespace nikitov
+{
+  template< class T >
+  class CowHandle
+  {
+  public:
+    CowHandle() = default;
+    explicit CowHandle(T&& value);
+    CowHandle(const CowHandle< T >& other) = default;
+    CowHandle(CowHandle< T >&& other) noexcept = default;
+    ~CowHandle() = default;
+
+    CowHandle< T >& operator=(const CowHandle< T >& other) = default;
+    CowHandle< T >& operator=(CowHandle< T >&& other) noexcept = default;
+
+    const T& operator*() const;
+    const T* operator->() const;
+    T& edit();
+
+    bool isShared() const noexcept;
+
+  private:
+    std::shared_ptr< T > data_;
+
+    static const T& getEmpty();
+  };
+
+  template< class T >
+  CowHandle< T >::CowHandle(T&& value):
+    data_(std::make_shared< T >(std::move(value)))
+  {}
+
+  template< class T >
+  const T& CowHandle< T >::operator*() const
+  {
+    return data_ ? *data_ : getEmpty();
+  }
+
+  template< class T >
+  const T* CowHandle< T >::operator->() const
+  {
+    return std::addressof(**this);
+  }
+
+  template< class T >
+  T& CowHandle< T >::edit()
+  {
+    if (!data_)
+    {
+      data_ = std::make_shared< T >();
+    }
+    else if (data_.use_count() > 1)
+    {
+      data_ = std::make_shared< T >(*data_);
+    }
+    return *data_;
+  }
+
+  template< class T >
+  bool CowHandle< T >::isShared() const noexcept
+  {
+    return data_ && data_.use_count() > 1;
+  }
+
+  template< class T >
+  const T& CowHandle< T >::getEmpty()
+  {
+    static const T empty;
+    return empty;
+  }
+}
+#endif
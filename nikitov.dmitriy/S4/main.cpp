@@ -12,7 +12,7 @@ int main(int argc, char* argv[])
 {
   using namespace nikitov;
 
-  using TreeOfDict = Tree< std::string, Tree< size_t, std::string > >;
+  using TreeOfDict = Tree< std::string, Dictionary >;
   TreeOfDict treeOfDictionaries;
   if (argc == 2)
   {
@@ -1,7 +1,8 @@
 #include "read_dictionaries.hpp"
 #include <string>
+#include <utility>
 
-void nikitov::readDictionaries(Tree< std::string, Tree< size_t, std::string > >& treeOfDictionaries, std::istream& input)
+void nikitov::readDictionaries(Tree< std::string, Dictionary >& treeOfDictionaries, std::istream& input)
 {
   while (!input.eof())
   {
@@ -14,9 +15,9 @@ void nikitov::readDictionaries(Tree< std::string, Tree< size_t, std::string > >&
     {
       std::string value = {};
       input >> value;
-      dictionary.insert({ key, value });
+      dictionary.emplaceHint(dictionary.cend(), key, std::move(value));
     }
 
-    treeOfDictionaries.insert({ nameOfDictionary, dictionary });
+    treeOfDictionaries.emplaceHint(treeOfDictionaries.cend(), std::move(nameOfDictionary), Dictionary(std::move(dictionary)));
   }
 }
@@ -3,9 +3,10 @@
 
 #include <istream>
 #include <tree.hpp>
+#include "commands.hpp"
 
 namespace nikitov
 {
-  void readDictionaries(Tree< std::string, Tree< size_t, std::string > >& treeOfDictionaries, std::istream& input);
+  void readDictionaries(Tree< std::string, Dictionary >& treeOfDictionaries, std::istream& input);
 }
 #endif
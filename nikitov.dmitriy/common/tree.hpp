@@ -53,8 +53,12 @@ namespace nikitov
 
     std::pair< treeIterator, bool > insert(const std::pair< Key, T >& value);
     std::pair< treeIterator, bool > insert(std::pair< Key, T >&& value);
+    treeIterator insert(constTreeIterator hint, const std::pair< Key, T >& value);
+    treeIterator insert(constTreeIterator hint, std::pair< Key, T >&& value);
     void insert(constTreeIterator first, constTreeIterator second);
     void insert(std::initializer_list< std::pair< Key, T > > initList);
+    template< class... Args >
+    treeIterator emplaceHint(constTreeIterator hint, Args&&... args);
 
     treeIterator erase(constTreeIterator position);
     treeIterator erase(constTreeIterator first, constTreeIterator last);
@@ -90,39 +94,37 @@ namespace nikitov
     detail::TreeNode< Key, T, Compare >* root_;
     size_t size_;
     Compare cmp_;
+    detail::TreeNode< Key, T, Compare >* last_;
 
     detail::TreeNode< Key, T, Compare >* search(detail::TreeNode< Key, T, Compare >* node, const Key& key) const;
     detail::TreeNode< Key, T, Compare >* findToInsert(const Key& value) const;
+    detail::TreeNode< Key, T, Compare >* findLast();
 
     std::pair< TreeIterator< Key, T, Compare >, bool > embed(const std::pair< Key, T >& value);
     std::pair< TreeIterator< Key, T, Compare >, bool > moveEmbed(std::pair< Key, T >&& value);
+    TreeIterator< Key, T, Compare > hintEmbed(constTreeIterator hint, std::pair< Key, T >&& value);
   };
 
   template< class Key, class T, class Compare >
   Tree< Key, T, Compare >::Tree():
     root_(new detail::TreeNode< Key, T, Compare >()),
     size_(0),
-    cmp_(Compare())
+    cmp_(Compare()),
+    last_(nullptr)
   {}
 
   template< class Key, class T, class Compare >
   Tree< Key, T, Compare >::Tree(constTreeIterator first, constTreeIterator second):
     Tree()
   {
-    for (auto i = first; i != second; ++i)
-    {
-      embed(*i);
-    }
+    insert(first, second);
   }
 
   template< class Key, class T, class Compare >
   Tree< Key, T, Compare >::Tree(std::initializer_list< std::pair< Key, T > > initList):
     Tree()
   {
-    for (auto i = initList.begin(); i != initList.end(); ++i)
-    {
-      embed(*i);
-    }
+    insert(initList);
   }
 
   template< class Key, class T, class Compare >
@@ -134,10 +136,12 @@ namespace nikitov
   Tree< Key, T, Compare >::Tree(Tree< Key, T, Compare >&& other) noexcept:
     root_(other.root_),
     size_(other.size_),
-    cmp_(other.cmp_)
+    cmp_(other.cmp_),
+    last_(other.last_)
   {
     other.root_ = new detail::TreeNode< Key, T, Compare >();
     other.size_ = 0;
+    other.last_ = nullptr;
   }
 
   template< class Key, class T, class Compare >
@@ -311,12 +315,25 @@ namespace nikitov
     return moveEmbed(std::move(value));
   }
 
+  template< class Key, class T, class Compare >
+  TreeIterator< Key, T, Compare > Tree< Key, T, Compare >::insert(constTreeIterator hint, const std::pair< Key, T >& value)
+  {
+    std::pair< Key, T > copy = value;
+    return hintEmbed(hint, std::move(copy));
+  }
+
+  template< class Key, class T, class Compare >
+  TreeIterator< Key, T, Compare > Tree< Key, T, Compare >::insert(constTreeIterator hint, std::pair< Key, T >&& value)
+  {
+    return hintEmbed(hint, std::move(value));
+  }
+
   template< class Key, class T, class Compare >
   void Tree< Key, T, Compare >::insert(constTreeIterator first, constTreeIterator second)
   {
     for (auto i = first; i != second; ++i)
     {
-      embed(*i);
+      insert(cend(), *i);
     }
   }
 
@@ -327,13 +344,21 @@ namespace nikitov
     auto end = initList.end();
     while (begin != end)
     {
-      embed(*begin++);
+      insert(cend(), *begin++);
     }
   }
 
+  template< class Key, class T, class Compare >
+  template< class... Args >
+  TreeIterator< Key, T, Compare > Tree< Key, T, Compare >::emplaceHint(constTreeIterator hint, Args&&... args)
+  {
+    return hintEmbed(hint, std::pair< Key, T >(std::forward< Args >(args)...));
+  }
+
   template< class Key, class T, class Compare >
   TreeIterator< Key, T, Compare > Tree< Key, T, Compare >::erase(constTreeIterator position)
   {
+    last_ = nullptr;
     if (size_ == 1)
     {
       root_ = root_->parent_;
@@ -408,6 +433,7 @@ namespace nikitov
       delete root_->middle_;
     }
     size_ = 0;
+    last_ = nullptr;
   }
 
   template< class Key, class T, class Compare >
@@ -416,6 +442,7 @@ namespace nikitov
     std::swap(root_, other.root_);
     std::swap(size_, other.size_);
     std::swap(cmp_, other.cmp_);
+    std::swap(last_, other.last_);
   }
 
   template< class Key, class T, class Compare >
@@ -663,8 +690,90 @@ namespace nikitov
       }
       isInserted = true;
       ++size_;
+      last_ = nullptr;
+    }
+    return std::pair< treeIterator, bool > { find(key), isInserted };
+  }
+
+  template< class Key, class T, class Compare >
+  detail::TreeNode< Key, T, Compare >* Tree< Key, T, Compare >::findLast()
+  {
+    if (!last_)
+    {
+      last_ = root_;
+      while (last_->right_)
+      {
+        last_ = last_->right_;
+      }
+    }
+    return last_;
+  }
+
+  template< class Key, class T, class Compare >
+  TreeIterator< Key, T, Compare > Tree< Key, T, Compare >::hintEmbed(constTreeIterator hint, std::pair< Key, T >&& value)
+  {
+    if (empty())
+    {
+      return moveEmbed(std::move(value)).first;
+    }
+    Key key = value.first;
+    detail::TreeNode< Key, T, Compare >* leaf = nullptr;
+    constTreeIterator prev = hint;
+    if (hint == cend())
+    {
+      leaf = findLast();
+      prev = constTreeIterator(leaf, leaf->size_ == 1);
+    }
+    else
+    {
+      if (!cmp_(key, (*hint).first))
+      {
+        if (!cmp_((*hint).first, key))
+        {
+          return treeIterator(hint.node_, hint.isFirst_);
+        }
+        return moveEmbed(std::move(value)).first;
+      }
+      if (hint.node_->isLeaf())
+      {
+        leaf = hint.node_;
+      }
+      if (hint != cbegin())
+      {
+        --prev;
+      }
+    }
+    if (prev != hint)
+    {
+      if (!cmp_((*prev).first, key))
+      {
+        if (!cmp_(key, (*prev).first))
+        {
+          return treeIterator(prev.node_, prev.isFirst_);
+        }
+        return moveEmbed(std::move(value)).first;
+      }
+      if (!leaf)
+      {
+        leaf = prev.node_;
+      }
+    }
+
+    bool isAppended = hint == cend();
+    detail::TreeNode< Key, T, Compare >* newRoot = leaf->moveAdd(std::move(value));
+    if (newRoot)
+    {
+      root_ = newRoot;
+    }
+    ++size_;
+    detail::TreeNode< Key, T, Compare >* node = search(leaf, key);
+    while (!node)
+    {
+      leaf = leaf->parent_;
+      node = search(leaf, key);
     }
-    return std::pair< treeIterator, bool > { find(value.first), isInserted };
+    last_ = isAppended ? node : nullptr;
+    return treeIterator(node, node->firstValue_.first == key);
   }
 }
 #endif
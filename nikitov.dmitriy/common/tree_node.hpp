@@ -49,7 +49,7 @@ namespace nikitov
       treeNode* split(const std::pair< Key, T >& value, treeNode* node);
 
       void fixOwn(treeNode* node);
-      void fixNeighbour(const List< treeNode* >& nodes);
+      void fixNeighbour(const List< treeNode* >& nodes, treeNode* neighbour = nullptr);
       void fixErase();
 
       void littleRotateRight();
@@ -58,6 +58,7 @@ namespace nikitov
       void rotateLeft();
 
       treeNode* findNeighbour() const;
+      treeNode* findRightNeighbour() const;
       size_t countHeight() const;
       bool isLeaf() const;
 
@@ -90,7 +91,7 @@ namespace nikitov
     template< class Key, class T, class Compare >
     bool TreeNode< Key, T, Compare >::find(const Key& key) const
     {
-      return firstValue_.first == key || (size_ == 2 && secondValue_.first == key);
+      return (size_ != 0 && firstValue_.first == key) || (size_ == 2 && secondValue_.first == key);
     }
 
     template< class Key, class T, class Compare >
@@ -211,14 +212,17 @@ namespace nikitov
       }
       else
       {
-        fixNeighbour(nodes);
+        fixNeighbour(nodes, findRightNeighbour());
       }
     }
 
     template< class Key, class T, class Compare >
-    void TreeNode< Key, T, Compare >::fixNeighbour(const List< treeNode* >& nodes)
+    void TreeNode< Key, T, Compare >::fixNeighbour(const List< treeNode* >& nodes, treeNode* neighbour)
     {
-      treeNode* neighbour = findNeighbour();
+      if (!neighbour)
+      {
+        neighbour = findNeighbour();
+      }
 
       auto iterator = nodes.cbegin();
       if (!cmp_(firstValue_.first, neighbour->firstValue_.first))
@@ -525,6 +529,28 @@ namespace nikitov
       return neighbour;
     }
 
+    template< class Key, class T, class Compare >
+    TreeNode< Key, T, Compare >* TreeNode< Key, T, Compare >::findRightNeighbour() const
+    {
+      const treeNode* node = this;
+      size_t depth = 0;
+      while (node->parent_->right_ == node)
+      {
+        node = node->parent_;
+        ++depth;
+      }
+      treeNode* neighbour = node->parent_->right_;
+      if (node->parent_->left_ == node && node->parent_->middle_)
+      {
+        neighbour = node->parent_->middle_;
+      }
+      for (; depth != 0; --depth)
+      {
+        neighbour = neighbour->left_;
+      }
+      return neighbour;
+    }
+
     template< class Key, class T, class Compare >
     size_t TreeNode< Key, T, Compare >::countHeight() const
     {
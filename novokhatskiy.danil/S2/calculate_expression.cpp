@@ -67,9 +67,9 @@ long long novokhatskiy::doMod(long long op1, long long op2)
   return res;
 }
 
-long long novokhatskiy::calculatePostExp(novokhatskiy::Queue< Postfix >&& inQueue)
+long long novokhatskiy::calculatePostExp(novokhatskiy::Queue< Postfix >&& inQueue, LineArena& arena)
 {
-  novokhatskiy::Stack< long long > stack;
+  novokhatskiy::Stack< long long > stack(arena);
   while (!inQueue.empty())
   {
     novokhatskiy::Postfix token = inQueue.front();
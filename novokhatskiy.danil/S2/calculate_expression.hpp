@@ -1,12 +1,13 @@
 #ifndef CALCULATE_EXPRESSION_HPP
 #define CALCULATE_EXPRESSION_HPP
 
+#include "line_arena.hpp"
 #include "queue.hpp"
 #include "tokens.hpp"
 
 namespace novokhatskiy
 {
-  long long calculatePostExp(Queue< Postfix >&& inQueue);
+  long long calculatePostExp(Queue< Postfix >&& inQueue, LineArena& arena);
   long long doAddition(long long op1, long long op2);
   long long doSubstraction(long long op1, long long op2);
   long long doMultiplication(long long op1, long long op2);
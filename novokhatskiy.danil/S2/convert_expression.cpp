@@ -25,10 +25,10 @@ bool novokhatskiy::checkPriority(InfixType type)
   return type.getType() != TokenType::BRACKET && getPriority(type.getOp()) >= getPriority(type.getOp());
 }
 
-novokhatskiy::Queue< novokhatskiy::Postfix > novokhatskiy::convertExpression(Queue< InfixType >&& infixQueue)
+novokhatskiy::Queue< novokhatskiy::Postfix > novokhatskiy::convertExpression(Queue< InfixType >&& infixQueue, LineArena& arena)
 {
-  novokhatskiy::Queue< novokhatskiy::Postfix > resultQueue;
-  novokhatskiy::Stack< novokhatskiy::InfixType > stack;
+  novokhatskiy::Queue< novokhatskiy::Postfix > resultQueue(arena);
+  novokhatskiy::Stack< novokhatskiy::InfixType > stack(arena);
   while (!infixQueue.empty())
   {
     novokhatskiy::InfixType curr = infixQueue.front();
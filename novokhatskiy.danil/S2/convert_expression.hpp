@@ -1,12 +1,13 @@
 #ifndef CONVERT_EXPRESSION_HPP
 #define CONVERT_EXPRESSION_HPP
 
+#include "line_arena.hpp"
 #include "queue.hpp"
 #include "tokens.hpp"
 
 namespace novokhatskiy
 {
-  Queue< novokhatskiy::Postfix > convertExpression(Queue< InfixType >&& infixQueue);
+  Queue< novokhatskiy::Postfix > convertExpression(Queue< InfixType >&& infixQueue, LineArena& arena);
   unsigned getPriority(Operation operation);
   bool checkPriority(InfixType type);
 }
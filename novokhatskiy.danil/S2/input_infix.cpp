@@ -1,60 +1,52 @@
 #include "input_infix.hpp"
 #include <string>
 
-void novokhatskiy::inputInfix(Queue< Queue< InfixType > >& infixQueue, std::istream& in)
+void novokhatskiy::inputInfix(Queue< InfixType >& infixQueue, std::istream& in)
 {
   in >> std::noskipws;
-  while (in)
+  char symb{};
+  while (in >> symb && symb != '\n' && !in.eof())
   {
-    char symb{};
-    Queue< InfixType > currQ;
-    while (in >> symb && symb != '\n' && !in.eof())
+    switch (symb)
     {
-      switch (symb)
+    case '+':
+    case '-':
+    case '*':
+    case '/':
+    case '%':
+      infixQueue.push(InfixType(symb));
+      break;
+    case '(':
+    case ')':
+      if (symb == '(')
       {
-      case '+':
-      case '-':
-      case '*':
-      case '/':
-      case '%':
-        currQ.push(InfixType(symb));
-        break;
-      case '(':
-      case ')':
-        if (symb == '(')
-        {
-          currQ.push(InfixType::openBracket());
-        }
-        else
+        infixQueue.push(InfixType::openBracket());
+      }
+      else
+      {
+        infixQueue.push(InfixType::closeBracket());
+      }
+      break;
+    default:
+      try
+      {
+        std::string str = {};
+        while (symb != ' ' && symb != '\n')
         {
-          currQ.push(InfixType::closeBracket());
+          str += symb;
+          in >> symb;
         }
+        infixQueue.push(InfixType(std::stoll(str)));
         break;
-      default:
-        try
-        {
-          std::string str = {};
-          while (symb != ' ' && symb != '\n')
-          {
-            str += symb;
-            in >> symb;
-          }
-          currQ.push(InfixType(std::stoll(str)));
-          break;
-        }
-        catch (const std::exception&)
-        {
-          break;
-        }
       }
-      if (symb == '\n')
+      catch (const std::exception&)
       {
         break;
       }
     }
-    if (!currQ.empty())
+    if (symb == '\n')
     {
-      infixQueue.push(currQ);
+      break;
     }
   }
   in >> std::skipws;
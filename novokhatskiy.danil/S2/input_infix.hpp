@@ -8,7 +8,7 @@
 
 namespace novokhatskiy
 {
-  void inputInfix(Queue< Queue< InfixType > >& infixQueue, std::istream& in);
+  void inputInfix(Queue< InfixType >& infixQueue, std::istream& in);
 }
 
 #endif
@@ -0,0 +1,72 @@
+#include "line_arena.hpp"
+#include <algorithm>
+#include <memory>
+
+novokhatskiy::LineArena::LineArena(size_t capacity):
+  block_(nullptr),
+  current_(nullptr),
+  end_(nullptr),
+  capacity_(capacity)
+{}
+
+novokhatskiy::LineArena::~LineArena()
+{
+  freeBlocks();
+}
+
+void* novokhatskiy::LineArena::allocate(size_t size, size_t alignment)
+{
+  void* place = current_;
+  size_t space = end_ - current_;
+  if (!block_ || !std::align(alignment, size, place, space))
+  {
+    addBlock(size + alignment);
+    place = current_;
+    space = end_ - current_;
+    std::align(alignment, size, place, space);
+  }
+  current_ = static_cast< char* >(place) + size;
+  return place;
+}
+
+void novokhatskiy::LineArena::reset() noexcept
+{
+  if (block_ && block_->next)
+  {
+    size_t total = 0;
+    for (Block* curr = block_; curr; curr = curr->next)
+    {
+      total += curr->capacity;
+    }
+    freeBlocks();
+    capacity_ = total;
+    return;
+  }
+  if (block_)
+  {
+    current_ = reinterpret_cast< char* >(block_ + 1);
+  }
+}
+
+void novokhatskiy::LineArena::addBlock(size_t minCapacity)
+{
+  size_t capacity = std::max(block_ ? 2 * block_->capacity : capacity_, minCapacity);
+  Block* block = static_cast< Block* >(::operator new(sizeof(Block) + capacity));
+  block->next = block_;
+  block->capacity = capacity;
+  block_ = block;
+  current_ = reinterpret_cast< char* >(block + 1);
+  end_ = current_ + capacity;
+}
+
+void novokhatskiy::LineArena::freeBlocks() noexcept
+{
+  while (block_)
+  {
+    Block* next = block_->next;
+    ::operator delete(block_);
+    block_ = next;
+  }
+  current_ = nullptr;
+  end_ = nullptr;
+}
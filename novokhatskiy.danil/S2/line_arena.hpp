@@ -0,0 +1,63 @@
+#ifndef LINE_ARENA_HPP
+#define LINE_ARENA_HPP
+
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <node.hpp>
+
+namespace novokhatskiy
+{
+  class LineArena
+  {
+  public:
+    explicit LineArena(size_t capacity = 4096);
+    LineArena(const LineArena&) = delete;
+    LineArena& operator=(const LineArena&) = delete;
+    ~LineArena();
+
+    void* allocate(size_t size, size_t alignment);
+    void reset() noexcept;
+
+  private:
+    struct Block
+    {
+      Block* next;
+      size_t capacity;
+    };
+    Block* block_;
+    char* current_;
+    char* end_;
+    size_t capacity_;
+
+    void addBlock(size_t minCapacity);
+    void freeBlocks() noexcept;
+  };
+
+  namespace detail
+  {
+    template < class T, class... Args >
+    Node< T >* createNode(LineArena* arena, Node< T >* next, Args&&... args)
+    {
+      if (!arena)
+      {
+        return new Node< T >(next, std::forward< Args >(args)...);
+      }
+      void* place = arena->allocate(sizeof(Node< T >), alignof(Node< T >));
+      return new (place) Node< T >(next, std::forward< Args >(args)...);
+    }
+
+    template < class T >
+    void destroyNode(LineArena* arena, Node< T >* node) noexcept
+    {
+      if (!arena)
+      {
+        delete node;
+        return;
+      }
+      node->~Node();
+    }
+  }
+}
+
+#endif
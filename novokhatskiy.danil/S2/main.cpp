@@ -6,38 +6,52 @@
 #include "calculate_expression.hpp"
 #include "convert_expression.hpp"
 #include "input_infix.hpp"
+#include "line_arena.hpp"
 #include "queue.hpp"
 #include "stack.hpp"
 #include "tokens.hpp"
 
+namespace
+{
+  void calculateLines(novokhatskiy::Stack< long long >& results, std::istream& in)
+  {
+    using namespace novokhatskiy;
+    LineArena arena;
+    while (in)
+    {
+      {
+        Queue< InfixType > infixQueue(arena);
+        inputInfix(infixQueue, in);
+        if (!infixQueue.empty())
+        {
+          results.push(calculatePostExp(convertExpression(std::move(infixQueue), arena), arena));
+        }
+      }
+      arena.reset();
+    }
+  }
+}
+
 int main(int argc, char** argv)
 {
   using namespace novokhatskiy;
-  Queue< Queue< InfixType > > infixQueue;
+  Stack< long long > stack;
   try
   {
     if (argc == 2)
     {
       std::ifstream in(argv[1]);
-      inputInfix(infixQueue, in);
+      calculateLines(stack, in);
     }
     else if (argc == 1)
     {
-      inputInfix(infixQueue, std::cin);
+      calculateLines(stack, std::cin);
     }
     else
     {
       std::cerr << "Wrong input arguments\n";
       return 1;
     }
-    Stack< long long > stack;
-    while (!infixQueue.empty())
-    {
-      Queue< InfixType > tmp = infixQueue.front();
-      infixQueue.pop();
-      Queue< Postfix > res = convertExpression(std::move(tmp));
-      stack.push(calculatePostExp(std::move(res)));
-    }
     bool firstExpression = true;
     while (!stack.empty())
     {
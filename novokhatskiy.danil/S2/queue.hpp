@@ -1,9 +1,11 @@
 #ifndef QUEUE_HPP
 #define QUEUE_HPP
 
-#include <forward_list.hpp>
-#include "forward_list_iterators.hpp"
-#include "tokens.hpp"
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <node.hpp>
+#include "line_arena.hpp"
 
 namespace novokhatskiy
 {
@@ -11,28 +13,71 @@ namespace novokhatskiy
   class Queue
   {
   public:
+    Queue():
+      arena_(nullptr),
+      head_(nullptr),
+      tail_(nullptr),
+      size_(0)
+    {}
+    explicit Queue(LineArena& arena):
+      arena_(std::addressof(arena)),
+      head_(nullptr),
+      tail_(nullptr),
+      size_(0)
+    {}
+    Queue(const Queue< T >&) = delete;
+    Queue(Queue< T >&& other) noexcept:
+      arena_(other.arena_),
+      head_(other.head_),
+      tail_(other.tail_),
+      size_(other.size_)
+    {
+      other.head_ = nullptr;
+      other.tail_ = nullptr;
+      other.size_ = 0;
+    }
+    Queue< T >& operator=(const Queue< T >&) = delete;
+    ~Queue()
+    {
+      clear();
+    }
+
     void push(const T& value)
     {
-      if (data_.cbegin() == data_.cend())
+      node_t* node = detail::createNode< T >(arena_, nullptr, value);
+      if (tail_)
       {
-        data_.push_front(value);
-        return;
+        tail_->next_ = node;
+      }
+      else
+      {
+        head_ = node;
       }
-      auto it = data_.cbegin();
-      for (auto it2 = ++(data_.cbegin()); it2 != data_.cend(); it++, it2++);
-      data_.insert_after(it, value);
+      tail_ = node;
+      ++size_;
     }
     bool empty() const noexcept
     {
-      return data_.empty();
+      return !head_;
     }
     size_t size() const noexcept
     {
-      return data_.size();
+      return size_;
     }
     void pop()
     {
-      data_.pop_front();
+      if (empty())
+      {
+        return;
+      }
+      node_t* temp = head_;
+      head_ = head_->next_;
+      if (!head_)
+      {
+        tail_ = nullptr;
+      }
+      detail::destroyNode(arena_, temp);
+      --size_;
     }
     T& front()
     {
@@ -40,11 +85,22 @@ namespace novokhatskiy
       {
         throw std::invalid_argument("Queue is empty");
       }
-      return data_.front();
+      return head_->value_;
+    }
+    void clear() noexcept
+    {
+      while (!empty())
+      {
+        pop();
+      }
     }
 
   private:
-    ForwardList< T > data_;
+    using node_t = detail::Node< T >;
+    LineArena* arena_;
+    node_t* head_;
+    node_t* tail_;
+    size_t size_;
   };
 }
 
@@ -1,8 +1,11 @@
 #ifndef STACK_HPP
 #define STACK_HPP
 
-#include <forward_list.hpp>
+#include <cstddef>
+#include <memory>
 #include <stdexcept>
+#include <node.hpp>
+#include "line_arena.hpp"
 
 namespace novokhatskiy
 {
@@ -10,13 +13,33 @@ namespace novokhatskiy
   class Stack
   {
   public:
+    Stack():
+      arena_(nullptr),
+      head_(nullptr),
+      size_(0)
+    {}
+    explicit Stack(LineArena& arena):
+      arena_(std::addressof(arena)),
+      head_(nullptr),
+      size_(0)
+    {}
+    Stack(const Stack< T >&) = delete;
+    Stack< T >& operator=(const Stack< T >&) = delete;
+    ~Stack()
+    {
+      while (!empty())
+      {
+        pop();
+      }
+    }
+
     T& top()
     {
       if (empty())
       {
         throw std::invalid_argument("Stack is empty");
       }
-      return data_.front();
+      return head_->value_;
     }
 
     const T& top() const
@@ -25,28 +48,39 @@ namespace novokhatskiy
       {
         throw std::invalid_argument("Stack is empty");
       }
-      return data_.front();
+      return head_->value_;
     }
 
     bool empty() const noexcept
     {
-      return data_.empty();
+      return !head_;
     }
     size_t size() const noexcept
     {
-      return data_.size();
+      return size_;
     }
     void push(const T& value)
     {
-      data_.push_front(value);
+      head_ = detail::createNode< T >(arena_, head_, value);
+      ++size_;
     }
     void pop()
     {
-      data_.pop_front();
+      if (empty())
+      {
+        return;
+      }
+      node_t* temp = head_;
+      head_ = head_->next_;
+      detail::destroyNode(arena_, temp);
+      --size_;
     }
 
   private:
-    ForwardList< T > data_;
+    using node_t = detail::Node< T >;
+    LineArena* arena_;
+    node_t* head_;
+    size_t size_;
   };
 }
 
@@ -25,6 +25,10 @@ int main(int argc, char* argv[])
   cmdsForCreate["complement"] = complement;
   cmdsForCreate["union"] = unionF;
   cmdsForCreate["intersect"] = intersect;
+  SplayPolicy frozen;
+  frozen.mode = SplayMode::FROZEN;
+  cmdsForOutput.set_splay_policy(frozen);
+  cmdsForCreate.set_splay_policy(frozen);
   std::string name = "";
   std::string nameDataSet = "";
   while (std::cin >> name)
@@ -0,0 +1,157 @@
+#define BOOST_TEST_MODULE S4
+#include <boost/test/included/unit_test.hpp>
+
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <tree.hpp>
+
+namespace
+{
+  using tree_t = piyavkin::Tree< int, int >;
+  using model_t = std::map< int, int >;
+
+  template< class ModelIt >
+  void checkSame(tree_t& tree, piyavkin::TreeIterator< int, int > it, const model_t& model, ModelIt expected)
+  {
+    if (expected == model.cend())
+    {
+      BOOST_REQUIRE(it == tree.end());
+    }
+    else
+    {
+      BOOST_REQUIRE(it != tree.end());
+      BOOST_REQUIRE_EQUAL(it->first, expected->first);
+    }
+  }
+
+  void checkContents(const tree_t& tree, const model_t& model)
+  {
+    BOOST_REQUIRE_EQUAL(tree.size(), model.size());
+    auto expected = model.cbegin();
+    for (auto it = tree.cbegin(); it != tree.cend(); ++it, ++expected)
+    {
+      BOOST_REQUIRE(expected != model.cend());
+      BOOST_REQUIRE_EQUAL(it->first, expected->first);
+      BOOST_REQUIRE_EQUAL(it->second, expected->second);
+    }
+    BOOST_REQUIRE(expected == model.cend());
+  }
+
+  void runMixed(const piyavkin::SplayPolicy& policy, unsigned seed)
+  {
+    const int maxKey = 200;
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution< int > keys(-5, maxKey + 5);
+    std::uniform_int_distribution< int > ops(0, 4);
+    tree_t tree;
+    tree.set_splay_policy(policy);
+    model_t model;
+    for (int step = 0; step < 3000; ++step)
+    {
+      int key = keys(gen);
+      switch (ops(gen))
+      {
+      case 0:
+        tree.insert(std::make_pair(key, step));
+        model.insert(std::make_pair(key, step));
+        break;
+      case 1:
+        BOOST_REQUIRE_EQUAL(tree.erase(key), model.erase(key));
+        break;
+      case 2:
+        checkSame(tree, tree.find(key), model, model.find(key));
+        break;
+      case 3:
+        checkSame(tree, tree.lower_bound(key), model, model.lower_bound(key));
+        break;
+      default:
+        checkSame(tree, tree.upper_bound(key), model, model.upper_bound(key));
+      }
+      if (step % 100 == 0)
+      {
+        checkContents(tree, model);
+      }
+    }
+    checkContents(tree, model);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(bounds_past_the_ends)
+{
+  tree_t tree;
+  BOOST_CHECK(tree.lower_bound(1) == tree.end());
+  BOOST_CHECK(tree.upper_bound(1) == tree.end());
+  for (int i = 0; i < 10; i += 2)
+  {
+    tree.insert(std::make_pair(i, i));
+  }
+  BOOST_CHECK(tree.lower_bound(9) == tree.end());
+  BOOST_CHECK(tree.upper_bound(8) == tree.end());
+  BOOST_CHECK_EQUAL(tree.lower_bound(-1)->first, 0);
+  BOOST_CHECK_EQUAL(tree.lower_bound(4)->first, 4);
+  BOOST_CHECK_EQUAL(tree.lower_bound(5)->first, 6);
+  BOOST_CHECK_EQUAL(tree.upper_bound(4)->first, 6);
+  BOOST_CHECK_EQUAL(tree.upper_bound(5)->first, 6);
+  const tree_t& ctree = tree;
+  BOOST_CHECK_EQUAL(ctree.upper_bound(4)->first, 6);
+  BOOST_CHECK(ctree.upper_bound(8) == ctree.cend());
+}
+
+BOOST_AUTO_TEST_CASE(full_policy_matches_model)
+{
+  runMixed(piyavkin::SplayPolicy(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(semi_policy_matches_model)
+{
+  piyavkin::SplayPolicy policy;
+  policy.mode = piyavkin::SplayMode::SEMI;
+  runMixed(policy, 2);
+  policy.levels = 1;
+  runMixed(policy, 3);
+}
+
+BOOST_AUTO_TEST_CASE(periodic_policy_matches_model)
+{
+  piyavkin::SplayPolicy policy;
+  policy.mode = piyavkin::SplayMode::PERIODIC;
+  policy.period = 3;
+  runMixed(policy, 4);
+}
+
+BOOST_AUTO_TEST_CASE(frozen_policy_matches_model)
+{
+  piyavkin::SplayPolicy policy;
+  policy.mode = piyavkin::SplayMode::FROZEN;
+  runMixed(policy, 5);
+}
+
+BOOST_AUTO_TEST_CASE(invalid_policies_are_rejected)
+{
+  tree_t tree;
+  piyavkin::SplayPolicy policy;
+  policy.mode = piyavkin::SplayMode::SEMI;
+  policy.levels = 0;
+  BOOST_CHECK_THROW(tree.set_splay_policy(policy), std::invalid_argument);
+  policy.mode = piyavkin::SplayMode::PERIODIC;
+  policy.period = 0;
+  BOOST_CHECK_THROW(tree.set_splay_policy(policy), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(stats_are_per_operation)
+{
+  tree_t tree;
+  for (int i = 0; i < 50; ++i)
+  {
+    tree.insert(std::make_pair(i, i));
+  }
+  tree.find(0);
+  tree.upper_bound(10);
+  using piyavkin::SplayOperation;
+  BOOST_CHECK_EQUAL(tree.splay_stats(SplayOperation::INSERT).accesses, 50);
+  BOOST_CHECK_EQUAL(tree.splay_stats(SplayOperation::FIND).accesses, 1);
+  BOOST_CHECK_EQUAL(tree.splay_stats(SplayOperation::UPPER_BOUND).accesses, 1);
+  BOOST_CHECK_EQUAL(tree.splay_stats(SplayOperation::LOWER_BOUND).accesses, 0);
+  BOOST_CHECK_EQUAL(tree.splay_stats().accesses, 52);
+}
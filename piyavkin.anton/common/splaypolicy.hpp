@@ -0,0 +1,43 @@
+#ifndef SPLAYPOLICY_HPP
+#define SPLAYPOLICY_HPP
+#include <cstddef>
+
+namespace piyavkin
+{
+  enum class SplayMode
+  {
+    FULL,
+    SEMI,
+    PERIODIC,
+    FROZEN
+  };
+
+  struct SplayPolicy
+  {
+    SplayMode mode = SplayMode::FULL;
+    // SEMI: accessed node is lifted by at most this many levels, at least 1
+    size_t levels = 2;
+    // PERIODIC: only every period-th access is splayed
+    size_t period = 1;
+  };
+
+  enum class SplayOperation
+  {
+    INSERT,
+    FIND,
+    LOWER_BOUND,
+    UPPER_BOUND,
+    EQUAL_RANGE
+  };
+  constexpr size_t splay_operations = 5;
+
+  // Counted per call: rotations of one equal_range cover every node it splays
+  struct SplayStats
+  {
+    size_t accesses = 0;
+    size_t splays = 0;
+    size_t rotations = 0;
+    size_t max_rotations = 0;
+  };
+}
+#endif
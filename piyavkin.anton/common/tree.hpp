@@ -1,7 +1,10 @@
 #ifndef TREE_HPP
 #define TREE_HPP
+#include <algorithm>
 #include <cstddef>
+#include <stdexcept>
 #include "treeiterator.hpp"
+#include "splaypolicy.hpp"
 #include "../S5/specialiterator.hpp"
 
 namespace piyavkin
@@ -16,7 +19,10 @@ namespace piyavkin
       cmp_(Compare()),
       size_(0),
       before_min_(Key(), nullptr, nullptr, std::addressof(end_node_), T()),
-      end_node_(Key(), nullptr, nullptr, std::addressof(before_min_), T())
+      end_node_(Key(), nullptr, nullptr, std::addressof(before_min_), T()),
+      policy_(),
+      stats_{},
+      access_count_(0)
     {}
     template< class InputIterator >
     Tree(InputIterator first, InputIterator second):
@@ -40,6 +46,7 @@ namespace piyavkin
     Tree(const Tree& rhs):
       Tree()
     {
+      policy_ = rhs.policy_;
       try
       {
         ConstTreeIterator< Key, T, Compare > it_right(rhs.root_);
@@ -66,8 +73,12 @@ namespace piyavkin
       cmp_(rhs.cmp_),
       size_(rhs.size_),
       before_min_(Key(), nullptr, nullptr, rhs.before_min_.parent_, T()),
-      end_node_(Key(), nullptr, nullptr, rhs.end_node_.parent_, T())
+      end_node_(Key(), nullptr, nullptr, rhs.end_node_.parent_, T()),
+      policy_(rhs.policy_),
+      stats_{},
+      access_count_(rhs.access_count_)
     {
+      std::copy(rhs.stats_, rhs.stats_ + splay_operations, stats_);
       rhs.root_ = nullptr;
       rhs.size_ = 0;
       end_node_.parent_->right_ = std::addressof(end_node_);
@@ -110,6 +121,9 @@ namespace piyavkin
       std::swap(root_, mp.root_);
       std::swap(cmp_, mp.cmp_);
       std::swap(size_, mp.size_);
+      std::swap(policy_, mp.policy_);
+      std::swap(stats_, mp.stats_);
+      std::swap(access_count_, mp.access_count_);
       detail::TreeNode< Key, T > temp1 = end_node_;
       detail::TreeNode< Key, T > temp2 = before_min_;
       end_node_.parent_ = mp.end_node_.parent_;
@@ -124,10 +138,47 @@ namespace piyavkin
         mp.end_node_.parent_->right_ = std::addressof(mp.end_node_);
       }
     }
+    void set_splay_policy(const SplayPolicy& policy)
+    {
+      if (policy.mode == SplayMode::PERIODIC && policy.period == 0)
+      {
+        throw std::invalid_argument("Splay period must be positive");
+      }
+      if (policy.mode == SplayMode::SEMI && policy.levels == 0)
+      {
+        throw std::invalid_argument("Splay levels must be positive");
+      }
+      policy_ = policy;
+      access_count_ = 0;
+    }
+    SplayPolicy splay_policy() const noexcept
+    {
+      return policy_;
+    }
+    const SplayStats& splay_stats(SplayOperation op) const noexcept
+    {
+      return stats_[static_cast< size_t >(op)];
+    }
+    SplayStats splay_stats() const noexcept
+    {
+      SplayStats total;
+      for (size_t i = 0; i < splay_operations; ++i)
+      {
+        total.accesses += stats_[i].accesses;
+        total.splays += stats_[i].splays;
+        total.rotations += stats_[i].rotations;
+        total.max_rotations = std::max(total.max_rotations, stats_[i].max_rotations);
+      }
+      return total;
+    }
+    void reset_splay_stats() noexcept
+    {
+      std::fill(stats_, stats_ + splay_operations, SplayStats());
+    }
     std::pair< TreeIterator< Key, T, Compare >, bool > insert(const val_type& val)
     {
       auto res = insert_impl(val);
-      splay(res.first.node_);
+      record(SplayOperation::INSERT, access(res.first.node_));
       return res;
     }
     std::pair< TreeIterator< Key, T, Compare >, bool > unsplay_insert(const val_type& val)
@@ -169,7 +220,7 @@ namespace piyavkin
           root_ = node;
         }
         ++size_;
-        splay(node);
+        record(SplayOperation::INSERT, access(node));
         return TreeIterator< Key, T, Compare >(node);
       }
       return insert(val).first;
@@ -217,10 +268,7 @@ namespace piyavkin
     TreeIterator< Key, T, Compare > find(const Key& key)
     {
       auto it = find_impl(key);
-      if (it != end())
-      {
-        splay(it.node_);
-      }
+      record(SplayOperation::FIND, it != end() ? access(it.node_) : 0);
       return it;
     }
     ConstTreeIterator< Key, T, Compare > find(const Key& key) const
@@ -229,38 +277,18 @@ namespace piyavkin
     }
     TreeIterator< Key, T, Compare > upper_bound(const Key& key)
     {
-      TreeIterator< Key, T, Compare > it = lower_bound_impl(key);
-      if (!cmp(it.node_->val_type.first, key) && !cmp(key, it.node_->val_type.first))
-      {
-        if (it != end())
-        {
-          splay(it.node_);
-        }
-        return it;
-      }
-      ++it;
-      if (it != end())
-      {
-        splay(it.node_);
-      }
-      return it;
+      auto it = upper_bound_impl(key);
+      record(SplayOperation::UPPER_BOUND, it != cend() ? access(const_cast< detail::TreeNode< Key, T >* >(it.node_)) : 0);
+      return TreeIterator< Key, T, Compare >(const_cast< detail::TreeNode< Key, T >* >(it.node_));
     }
     ConstTreeIterator< Key, T, Compare > upper_bound(const Key& key) const
     {
-      ConstTreeIterator< Key, T, Compare > it = lower_bound(key);
-      if (equal_key(it.node_->val_type.first, key))
-      {
-        return it;
-      }
-      return ++it;
+      return upper_bound_impl(key);
     }
     TreeIterator< Key, T, Compare > lower_bound(const Key& key)
     {
-      auto it = static_cast< const Tree< Key, T, Compare >& >(*this).lower_bound(key);
-      if (it != end())
-      {
-        splay(it.node_);
-      }
+      auto it = lower_bound_impl(key);
+      record(SplayOperation::LOWER_BOUND, it != cend() ? access(const_cast< detail::TreeNode< Key, T >* >(it.node_)) : 0);
       return TreeIterator< Key, T, Compare >(const_cast< detail::TreeNode< Key, T >* >(it.node_));
     }
     ConstTreeIterator< Key, T, Compare > lower_bound(const Key& key) const
@@ -273,11 +301,12 @@ namespace piyavkin
     }
     T& at(const Key& key)
     {
-      if (find(key) == end())
+      auto it = find(key);
+      if (it == end())
       {
         throw std::out_of_range("No data with this key");
       }
-      return operator[](key);
+      return it->second;
     }
     const T& at(const Key& key) const
     {
@@ -289,116 +318,67 @@ namespace piyavkin
     }
     TreeIterator< Key, T, Compare > erase(TreeIterator< Key, T, Compare > pos)
     {
-      TreeIterator< Key, T, Compare > delete_node = find_impl(pos.node_->val_type.first);
-      if (delete_node == end())
+      detail::TreeNode< Key, T >* node = pos.node_;
+      if (!node || isSentinel(node))
       {
-        return delete_node;
+        return end();
       }
-      TreeIterator< Key, T, Compare > result = delete_node;
+      TreeIterator< Key, T, Compare > result = pos;
       ++result;
-      detail::TreeNode< Key, T >* node = delete_node.node_->right_;
-      if (!node || delete_node.node_->right_ == std::addressof(end_node_))
+      bool isMin = node->left_ == std::addressof(before_min_);
+      bool isMax = node->right_ == std::addressof(end_node_);
+      detail::TreeNode< Key, T >* left = isMin ? nullptr : node->left_;
+      detail::TreeNode< Key, T >* right = isMax ? nullptr : node->right_;
+      detail::TreeNode< Key, T >* parent = node->parent_;
+      if (!left || !right)
       {
-        if ((size_ == 1) || (delete_node.node_->parent_ && !delete_node.node_->parent_->left_))
-        {
-          if (size_ != 1 && delete_node.node_->right_)
-          {
-            delete_node.node_->parent_->right_ = std::addressof(end_node_);
-          }
-          delete delete_node.node_;
-          --size_;
-          return result;
-        }
-        node = delete_node.node_->left_;
-        while (node && node->right_)
-        {
-          node = node->right_;
-        }
-        if (node)
-        {
-          if (node != delete_node.node_->left_)
-          {
-            node->left_ = delete_node.node_->left_;
-            delete_node.node_->left_->parent_ = node;
-          }
-          if (isLeftChild(node))
-          {
-            node->parent_->left_ = nullptr;
-          }
-          else
-          {
-            node->parent_->right_ = nullptr;
-          }
-          node->parent_ = delete_node.node_->parent_;
-          if (delete_node.node_->right_)
-          {
-            end_node_.parent_ = node;
-            node->right_ = std::addressof(end_node_);
-          }
-        }
-        if (isLeftChild(delete_node.node_))
-        {
-          delete_node.node_->parent_->left_ = node;
-        }
-        else if (isRightChild(delete_node.node_))
-        {
-          delete_node.node_->parent_->right_ = node;
-        }
-        if (delete_node.node_ == root_)
-        {
-          root_ = node;
-        }
-        delete delete_node.node_;
-        --size_;
-        return result;
-      }
-      while (node && node->left_)
-      {
-        node = node->left_;
+        transplant(node, left ? left : right);
       }
-      if (node)
+      else
       {
-        node->left_ = delete_node.node_->left_;
-        if (isLeftChild(node))
+        detail::TreeNode< Key, T >* next = right;
+        while (next->left_)
         {
-          node->parent_->left_ = node->right_;
+          next = next->left_;
         }
-        else if (isRightChild(node))
+        if (next != right)
         {
-          node->parent_->right_ = node->right_;
+          transplant(next, next->right_);
+          next->right_ = right;
+          right->parent_ = next;
         }
-        if (node->right_)
-        {
-          node->right_->parent_ = node->parent_;
-        }
-        if (!(delete_node.node_->right_ == node))
-        {
-          node->right_ = delete_node.node_->right_;
-        }
-        node->parent_ = delete_node.node_->parent_;
-      }
-      if (delete_node.node_->left_ && delete_node.node_->left_ != node)
-      {
-        delete_node.node_->left_->parent_ = node;
-      }
-      if (delete_node.node_->right_ && delete_node.node_->right_ != node)
-      {
-        delete_node.node_->right_->parent_ = node;
+        transplant(node, next);
+        next->left_ = left;
+        left->parent_ = next;
       }
-      if (isLeftChild(delete_node.node_))
+      delete node;
+      --size_;
+      if (!root_)
       {
-        delete_node.node_->parent_->left_ = node;
+        before_min_.parent_ = std::addressof(end_node_);
+        end_node_.parent_ = std::addressof(before_min_);
+        return end();
       }
-      else if (isRightChild(delete_node.node_))
+      if (isMin)
       {
-        delete_node.node_->parent_->right_ = node;
+        detail::TreeNode< Key, T >* min = right ? right : parent;
+        while (right && min->left_)
+        {
+          min = min->left_;
+        }
+        min->left_ = std::addressof(before_min_);
+        before_min_.parent_ = min;
       }
-      if (delete_node.node_ == root_)
+      if (isMax)
       {
-        root_ = node;
+        detail::TreeNode< Key, T >* max = left ? left : parent;
+        while (left && max->right_)
+        {
+          max = max->right_;
+        }
+        max->right_ = std::addressof(end_node_);
+        end_node_.parent_ = max;
       }
-      delete delete_node.node_;
-      --size_;
       return result;
     }
     TreeIterator< Key, T, Compare > erase(TreeIterator< Key, T, Compare > start, TreeIterator< Key, T, Compare > finish)
@@ -411,19 +391,37 @@ namespace piyavkin
     }
     void clear()
     {
-      while (!empty())
+      detail::TreeNode< Key, T >* node = root_;
+      while (node)
       {
-        erase(TreeIterator< Key, T, Compare >(root_));
+        detail::TreeNode< Key, T >* left = isSentinel(node->left_) ? nullptr : node->left_;
+        if (left)
+        {
+          node->left_ = left->right_;
+          left->right_ = node;
+          node = left;
+        }
+        else
+        {
+          detail::TreeNode< Key, T >* right = isSentinel(node->right_) ? nullptr : node->right_;
+          delete node;
+          node = right;
+        }
       }
+      root_ = nullptr;
+      size_ = 0;
+      before_min_.parent_ = std::addressof(end_node_);
+      end_node_.parent_ = std::addressof(before_min_);
     }
     size_t erase(const Key& key)
     {
-      size_t count = 0;
-      while (erase(find(key)) != end())
+      TreeIterator< Key, T, Compare > it = find_impl(key);
+      if (it == end())
       {
-        ++count;
+        return 0;
       }
-      return count;
+      erase(it);
+      return 1;
     }
     std::pair< ConstTreeIterator< Key, T, Compare >, ConstTreeIterator< Key, T, Compare > > equal_range(const Key& key) const
     {
@@ -455,12 +453,14 @@ namespace piyavkin
       TreeIterator< Key, T, Compare > it1(const_cast< detail::TreeNode< Key, T >* >(pair.first.node_));
       TreeIterator< Key, T, Compare > it2(const_cast< detail::TreeNode< Key, T >* >(pair.second.node_));
       auto res = it1;
+      size_t rotations = 0;
       while (it1 != it2)
       {
         detail::TreeNode< Key, T >* splayNode = it1.node_;
         ++it1;
-        splay(splayNode);
+        rotations += access(splayNode);
       }
+      record(SplayOperation::EQUAL_RANGE, rotations);
       return std::pair< TreeIterator< Key, T, Compare >, TreeIterator< Key, T, Compare > >(res, it2);
     }
     size_t count(const Key& key) const
@@ -568,6 +568,13 @@ namespace piyavkin
     size_t size_;
     detail::TreeNode< Key, T > before_min_;
     detail::TreeNode< Key, T > end_node_;
+    SplayPolicy policy_;
+    SplayStats stats_[splay_operations];
+    size_t access_count_;
+    bool isSentinel(const detail::TreeNode< Key, T >* node) const
+    {
+      return node == std::addressof(before_min_) || node == std::addressof(end_node_);
+    }
     bool isLeftChild(const detail::TreeNode< Key, T >* node) const
     {
       return (node->parent_ && node->parent_->left_ == node);
@@ -596,6 +603,25 @@ namespace piyavkin
     {
       return isRightChild(node) && cmp_(node->parent_->val_type.first, key);
     }
+    void transplant(detail::TreeNode< Key, T >* node, detail::TreeNode< Key, T >* child)
+    {
+      if (!node->parent_)
+      {
+        root_ = child;
+      }
+      else if (node->parent_->left_ == node)
+      {
+        node->parent_->left_ = child;
+      }
+      else
+      {
+        node->parent_->right_ = child;
+      }
+      if (child)
+      {
+        child->parent_ = node->parent_;
+      }
+    }
     void zig(detail::TreeNode< Key, T >* node)
     {
       detail::TreeNode< Key, T >* temp = node->left_;
@@ -644,11 +670,39 @@ namespace piyavkin
       }
       node->parent_ = temp;
     }
-    void splay(detail::TreeNode< Key, T >* node)
+    size_t access(detail::TreeNode< Key, T >* node)
     {
-      while (node->parent_)
+      if (policy_.mode == SplayMode::FROZEN)
       {
-        if (!node->parent_->parent_)
+        return 0;
+      }
+      if (policy_.mode == SplayMode::PERIODIC && ++access_count_ % policy_.period != 0)
+      {
+        return 0;
+      }
+      return splay(node, policy_.mode == SplayMode::SEMI ? policy_.levels : size_);
+    }
+    void record(SplayOperation op, size_t rotations)
+    {
+      if (policy_.mode == SplayMode::FROZEN)
+      {
+        return;
+      }
+      SplayStats& stats = stats_[static_cast< size_t >(op)];
+      ++stats.accesses;
+      if (rotations != 0)
+      {
+        ++stats.splays;
+        stats.rotations += rotations;
+        stats.max_rotations = std::max(stats.max_rotations, rotations);
+      }
+    }
+    size_t splay(detail::TreeNode< Key, T >* node, size_t levels)
+    {
+      size_t rotations = 0;
+      while (node->parent_ && rotations < levels)
+      {
+        if (!node->parent_->parent_ || rotations + 1 == levels)
         {
           if (isLeftChild(node))
           {
@@ -658,10 +712,12 @@ namespace piyavkin
           {
             zag(node->parent_);
           }
+          ++rotations;
+          continue;
         }
-        else if (isLeftChild(node->parent_) && isLeftChild(node))
+        if (isLeftChild(node->parent_) && isLeftChild(node))
         {
-          zig(node->parent_);
+          zig(node->parent_->parent_);
           zig(node->parent_);
         }
         else if (isLeftChild(node) && isRightChild(node->parent_))
@@ -676,10 +732,12 @@ namespace piyavkin
         }
         else
         {
-          zag(node->parent_);
+          zag(node->parent_->parent_);
           zag(node->parent_);
         }
+        rotations += 2;
       }
+      return rotations;
     }
     std::pair< TreeIterator< Key, T, Compare >, bool > insert_impl(const val_type& val)
     {
@@ -740,30 +798,43 @@ namespace piyavkin
       ++size_;
       return std::make_pair< TreeIterator< Key, T, Compare >, bool >(TreeIterator< Key, T, Compare >(node), true);
     }
+    // Both bounds return cend() rather than a null node when nothing qualifies,
+    // so callers can splay whatever does not compare equal to cend()
     ConstTreeIterator< Key, T, Compare > lower_bound_impl(const Key& key) const
     {
-      detail::TreeNode< Key, T >* curr_node = root_;
-      while (curr_node && (curr_node != std::addressof(end_node_) && curr_node != std::addressof(before_min_)))
+      const detail::TreeNode< Key, T >* result = std::addressof(end_node_);
+      const detail::TreeNode< Key, T >* curr_node = root_;
+      while (curr_node && !isSentinel(curr_node))
       {
         if (cmp_(curr_node->val_type.first, key))
         {
-          if (!curr_node->right_)
-          {
-            ConstTreeIterator< Key, T, Compare > it(curr_node);
-            return ++it;
-          }
           curr_node = curr_node->right_;
         }
         else
         {
-          if (!cmp_(key, curr_node->val_type.first) || (curr_node->left_ == std::addressof(before_min_)))
-          {
-            return ConstTreeIterator< Key, T, Compare >(curr_node);
-          }
+          result = curr_node;
           curr_node = curr_node->left_;
         }
       }
-      return ConstTreeIterator< Key, T, Compare >(curr_node);
+      return ConstTreeIterator< Key, T, Compare >(const_cast< detail::TreeNode< Key, T >* >(result));
+    }
+    ConstTreeIterator< Key, T, Compare > upper_bound_impl(const Key& key) const
+    {
+      const detail::TreeNode< Key, T >* result = std::addressof(end_node_);
+      const detail::TreeNode< Key, T >* curr_node = root_;
+      while (curr_node && !isSentinel(curr_node))
+      {
+        if (cmp_(key, curr_node->val_type.first))
+        {
+          result = curr_node;
+          curr_node = curr_node->left_;
+        }
+        else
+        {
+          curr_node = curr_node->right_;
+        }
+      }
+      return ConstTreeIterator< Key, T, Compare >(const_cast< detail::TreeNode< Key, T >* >(result));
     }
     TreeIterator< Key, T, Compare > find_impl(const Key& key)
     {
@@ -773,7 +844,7 @@ namespace piyavkin
     ConstTreeIterator< Key, T, Compare > find_impl(const Key& key) const
     {
       ConstTreeIterator< Key, T, Compare > it = lower_bound_impl(key);
-      if (!it.node_ || !equal_key(it.node_->val_type.first, key))
+      if (it == cend() || !equal_key(it.node_->val_type.first, key))
       {
         return cend();
       }
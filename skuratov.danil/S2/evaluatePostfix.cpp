@@ -65,6 +65,7 @@ void skuratov::evaluatePostfixExpression(const std::string& exp, Queue< long lon
       i++;
       continue;
     }
+    stats::countToken(stats::EVALUATE_POSTFIX);
     if (exp[i] == '+' || exp[i] == '-' || exp[i] == '*' || exp[i] == '/' || exp[i] == '%')
     {
       if (operands.size() < 2)
@@ -85,6 +86,7 @@ void skuratov::evaluatePostfixExpression(const std::string& exp, Queue< long lon
         operand += exp[i++];
       }
       operands.push(std::stoll(operand));
+      stats::trackDepth(stats::EVALUATE_POSTFIX, operands.size());
       i--;
     }
     i++;
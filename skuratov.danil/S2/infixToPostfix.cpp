@@ -18,9 +18,11 @@ std::string skuratov::infixToPostfix(const std::string& exp)
       i++;
       continue;
     }
+    stats::countToken(stats::INFIX_TO_POSTFIX);
     if (exp[i] == '(')
     {
       operators.push("(");
+      stats::trackDepth(stats::INFIX_TO_POSTFIX, operators.size());
     }
     else if (exp[i] == '+' || exp[i] == '-' || exp[i] == '*' || exp[i] == '/' || exp[i] == '%')
     {
@@ -31,6 +33,7 @@ std::string skuratov::infixToPostfix(const std::string& exp)
         operators.drop();
       }
       operators.push(op);
+      stats::trackDepth(stats::INFIX_TO_POSTFIX, operators.size());
     }
     else if (exp[i] == ')')
     {
@@ -5,6 +5,7 @@
 #include <iostream>
 #include "queue.hpp"
 #include "stack.hpp"
+#include "statistics.hpp"
 
 namespace skuratov
 {
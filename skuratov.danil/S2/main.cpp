@@ -1,39 +1,22 @@
 #include <fstream>
 #include "evaluatePostfix.hpp"
+#include "statistics.hpp"
 
-int main(int argc, char* argv[])
+namespace
 {
-  using namespace skuratov;
-
-  Queue< long long int > resultQueue;
-  std::string line;
-  char symb = {};
-
-  if (argc > 1)
+  bool readExpression(std::istream& in, std::string& line)
   {
-    std::ifstream infile(argv[1]);
-    if (!infile)
-    {
-      std::cerr << "Error reading file" << '\n';
-      return 1;
-    }
-    while (infile.get(symb))
+    skuratov::stats::PhaseTimer timer(skuratov::stats::READ);
+    line.clear();
+    char symb = {};
+    while (in.get(symb))
     {
+      skuratov::stats::countToken(skuratov::stats::READ);
       if (symb == '\n')
       {
         if (!line.empty())
         {
-          try
-          {
-            std::string postfixExp = infixToPostfix(line);
-            evaluatePostfixExpression(postfixExp, resultQueue);
-          }
-          catch (const std::exception& e)
-          {
-            std::cerr << "Error: " << e.what() << '\n';
-            return 1;
-          }
-          line.clear();
+          return true;
         }
       }
       else
@@ -41,59 +24,54 @@ int main(int argc, char* argv[])
         line += symb;
       }
     }
-    if (!line.empty())
+    return !line.empty();
+  }
+
+  void calculateExpression(const std::string& line, skuratov::Queue< long long int >& resultQueue)
+  {
+    using namespace skuratov;
+    std::string postfixExp;
     {
-      try
-      {
-        std::string postfixExp = infixToPostfix(line);
-        evaluatePostfixExpression(postfixExp, resultQueue);
-      }
-      catch (const std::exception& e)
-      {
-        std::cerr << "Error: " << e.what() << '\n';
-        return 1;
-      }
+      stats::PhaseTimer timer(stats::INFIX_TO_POSTFIX);
+      postfixExp = infixToPostfix(line);
+    }
+    stats::PhaseTimer timer(stats::EVALUATE_POSTFIX);
+    evaluatePostfixExpression(postfixExp, resultQueue);
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  using namespace skuratov;
+
+  Queue< long long int > resultQueue;
+  std::string line;
+
+  std::ifstream infile;
+  if (argc > 1)
+  {
+    infile.open(argv[1]);
+    if (!infile)
+    {
+      std::cerr << "Error reading file" << '\n';
+      return 1;
     }
   }
-  else
+  std::istream& in = (argc > 1) ? infile : std::cin;
+
+  stats::LineTimer lineTimer;
+  while (readExpression(in, line))
   {
-    while (std::cin.get(symb))
+    try
     {
-      if (symb == '\n')
-      {
-        if (!line.empty())
-        {
-          try
-          {
-            std::string postfixExp = infixToPostfix(line);
-            evaluatePostfixExpression(postfixExp, resultQueue);
-          }
-          catch (const std::exception& e)
-          {
-            std::cerr << "Error: " << e.what() << '\n';
-            return 1;
-          }
-          line.clear();
-        }
-      }
-      else
-      {
-        line += symb;
-      }
+      calculateExpression(line, resultQueue);
     }
-    if (!line.empty())
+    catch (const std::exception& e)
     {
-      try
-      {
-        std::string postfixExp = infixToPostfix(line);
-        evaluatePostfixExpression(postfixExp, resultQueue);
-      }
-      catch (const std::exception& e)
-      {
-        std::cerr << "Error: " << e.what() << '\n';
-        return 1;
-      }
+      std::cerr << "Error: " << e.what() << '\n';
+      return 1;
     }
+    lineTimer.lap();
   }
   printReverse(resultQueue);
   std::cout << '\n';
@@ -2,6 +2,7 @@
 #define STACK_HPP
 
 #include <list.hpp>
+#include "statistics.hpp"
 
 namespace skuratov
 {
@@ -11,6 +12,7 @@ namespace skuratov
   public:
     void push(const T& diff)
     {
+      stats::countAllocation();
       stack_.pushBack(diff);
     }
     void drop()
@@ -0,0 +1,108 @@
+#include "statistics.hpp"
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+namespace
+{
+  constexpr size_t bucketsCount = 32;
+
+  struct Counters
+  {
+    long long phaseTime[skuratov::stats::PHASE_COUNT];
+    size_t tokens[skuratov::stats::PHASE_COUNT];
+    size_t maxDepth[skuratov::stats::PHASE_COUNT];
+    size_t allocations;
+    size_t lines;
+    size_t histogram[bucketsCount];
+  };
+
+  const char* phaseNames[skuratov::stats::PHASE_COUNT] = { "read", "infix_to_postfix", "evaluate_postfix" };
+
+  size_t getBucket(long long micros) noexcept
+  {
+    size_t bucket = 0;
+    while (micros > 0 && bucket + 1 < bucketsCount)
+    {
+      micros >>= 1;
+      ++bucket;
+    }
+    return bucket;
+  }
+
+  void printJson(std::ostream& out, const Counters& counters)
+  {
+    out << "{\"lines\":" << counters.lines;
+    out << ",\"allocations\":" << counters.allocations;
+    out << ",\"phases\":{";
+    for (size_t i = 0; i < skuratov::stats::PHASE_COUNT; ++i)
+    {
+      out << (i ? "," : "") << '"' << phaseNames[i] << "\":{";
+      out << "\"time_ns\":" << counters.phaseTime[i];
+      out << ",\"tokens\":" << counters.tokens[i];
+      out << ",\"max_stack_depth\":" << counters.maxDepth[i] << '}';
+    }
+    out << "},\"line_latency_us\":[";
+    bool isFirst = true;
+    for (size_t i = 0; i < bucketsCount; ++i)
+    {
+      if (counters.histogram[i] != 0)
+      {
+        out << (isFirst ? "" : ",") << "{\"below\":" << (1ull << i) << ",\"count\":" << counters.histogram[i] << '}';
+        isFirst = false;
+      }
+    }
+    out << "]}\n";
+  }
+
+  struct Report
+  {
+    Counters counters;
+    ~Report()
+    {
+      if (skuratov::stats::enabled)
+      {
+        printJson(std::cerr, counters);
+      }
+    }
+  };
+
+  Report report = {};
+
+  bool readFlag() noexcept
+  {
+    const char* value = std::getenv("SKURATOV_S2_STATS");
+    return value && *value && std::strcmp(value, "0") != 0;
+  }
+}
+
+const bool skuratov::stats::enabled = readFlag();
+
+void skuratov::stats::detail::addPhaseTime(Phase phase, clock_type::duration time) noexcept
+{
+  report.counters.phaseTime[phase] += std::chrono::duration_cast< std::chrono::nanoseconds >(time).count();
+}
+
+void skuratov::stats::detail::addToken(Phase phase) noexcept
+{
+  ++report.counters.tokens[phase];
+}
+
+void skuratov::stats::detail::updateDepth(Phase phase, size_t depth) noexcept
+{
+  if (depth > report.counters.maxDepth[phase])
+  {
+    report.counters.maxDepth[phase] = depth;
+  }
+}
+
+void skuratov::stats::detail::addAllocation() noexcept
+{
+  ++report.counters.allocations;
+}
+
+void skuratov::stats::detail::addLine(clock_type::duration latency) noexcept
+{
+  ++report.counters.lines;
+  ++report.counters.histogram[getBucket(std::chrono::duration_cast< std::chrono::microseconds >(latency).count())];
+}
@@ -0,0 +1,103 @@
+#ifndef STATISTICS_HPP
+#define STATISTICS_HPP
+
+#include <chrono>
+#include <cstddef>
+
+namespace skuratov
+{
+  namespace stats
+  {
+    enum Phase
+    {
+      READ,
+      INFIX_TO_POSTFIX,
+      EVALUATE_POSTFIX,
+      PHASE_COUNT
+    };
+
+    using clock_type = std::chrono::steady_clock;
+
+    // Set once at startup from the SKURATOV_S2_STATS environment variable
+    extern const bool enabled;
+
+    namespace detail
+    {
+      void addPhaseTime(Phase phase, clock_type::duration time) noexcept;
+      void addToken(Phase phase) noexcept;
+      void updateDepth(Phase phase, size_t depth) noexcept;
+      void addAllocation() noexcept;
+      void addLine(clock_type::duration latency) noexcept;
+    }
+
+    class PhaseTimer
+    {
+    public:
+      explicit PhaseTimer(Phase phase) noexcept:
+        phase_(phase),
+        start_(enabled ? clock_type::now() : clock_type::time_point())
+      {}
+      PhaseTimer(const PhaseTimer&) = delete;
+      PhaseTimer& operator=(const PhaseTimer&) = delete;
+      ~PhaseTimer()
+      {
+        if (enabled)
+        {
+          detail::addPhaseTime(phase_, clock_type::now() - start_);
+        }
+      }
+
+    private:
+      Phase phase_;
+      clock_type::time_point start_;
+    };
+
+    class LineTimer
+    {
+    public:
+      LineTimer() noexcept:
+        start_(enabled ? clock_type::now() : clock_type::time_point())
+      {}
+      LineTimer(const LineTimer&) = delete;
+      LineTimer& operator=(const LineTimer&) = delete;
+      void lap() noexcept
+      {
+        if (enabled)
+        {
+          clock_type::time_point now = clock_type::now();
+          detail::addLine(now - start_);
+          start_ = now;
+        }
+      }
+
+    private:
+      clock_type::time_point start_;
+    };
+
+    inline void countToken(Phase phase) noexcept
+    {
+      if (enabled)
+      {
+        detail::addToken(phase);
+      }
+    }
+
+    inline void trackDepth(Phase phase, size_t depth) noexcept
+    {
+      if (enabled)
+      {
+        detail::updateDepth(phase, depth);
+      }
+    }
+
+    inline void countAllocation() noexcept
+    {
+      if (enabled)
+      {
+        detail::addAllocation();
+      }
+    }
+  }
+}
+
+#endif
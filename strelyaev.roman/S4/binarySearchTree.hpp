@@ -3,7 +3,9 @@
 #include <functional>
 #include <cassert>
 #include <stdexcept>
+#include <memory>
 #include "node.hpp"
+#include "nodePool.hpp"
 #include "treeIterator.hpp"
 #include "constTreeIterator.hpp"
 
@@ -16,15 +18,21 @@ namespace strelyaev
     using iterator_t = Iterator< Key, T >;
     using c_iterator_t = ConstIterator< Key, T >;
     using tree_t = Tree< Key, T, Compare >;
+    using pool_t = detail::NodePool< Key, T >;
     public:
       Tree():
+        Tree(pool_t::shared())
+      {}
+
+      explicit Tree(std::shared_ptr< pool_t > pool):
         root_(nullptr),
         cmp_(Compare()),
-        size_(0)
+        size_(0),
+        pool_(pool)
       {}
 
       Tree(const tree_t& other):
-        Tree()
+        Tree(other.pool_)
       {
         if (other.root_)
         {
@@ -38,7 +46,8 @@ namespace strelyaev
       Tree(tree_t&& other):
         root_(other.root_),
         cmp_(other.cmp_),
-        size_(other.size_)
+        size_(other.size_),
+        pool_(other.pool_)
       {
         other.root_ = nullptr;
         other.cmp_ = Compare();
@@ -75,6 +84,7 @@ namespace strelyaev
         std::swap(other.root_, root_);
         std::swap(other.size_, size_);
         std::swap(other.cmp_, cmp_);
+        std::swap(other.pool_, pool_);
       }
 
       iterator_t insert(const std::pair< Key, T >& pair)
@@ -86,7 +96,7 @@ namespace strelyaev
       {
         if (!root_)
         {
-          root_ = new node_t(nullptr, nullptr, nullptr, key, value);
+          root_ = pool_->acquire(nullptr, nullptr, nullptr, key, value);
           size_++;
           return iterator_t(root_);
         }
@@ -106,11 +116,11 @@ namespace strelyaev
         }
         if (cmp_(key, parent->data_.first))
         {
-          parent->left_ = new node_t(nullptr, parent, nullptr, key, value);
+          parent->left_ = pool_->acquire(nullptr, parent, nullptr, key, value);
         }
         else
         {
-          parent->right_ = new node_t(nullptr, parent, nullptr, key, value);
+          parent->right_ = pool_->acquire(nullptr, parent, nullptr, key, value);
         }
         size_++;
         while (parent)
@@ -267,12 +277,14 @@ namespace strelyaev
       {
         clear(root_);
         root_ = nullptr;
+        size_ = 0;
       }
 
     private:
       node_t* root_;
       Compare cmp_;
       size_t size_;
+      std::shared_ptr< pool_t > pool_;
 
       void clear(node_t* node) noexcept
       {
@@ -280,7 +292,7 @@ namespace strelyaev
         {
           clear(node->right_);
           clear (node->left_);
-          delete node;
+          pool_->release(node);
         }
       }
 
@@ -1,11 +1,12 @@
 #include "commands.hpp"
 #include <iostream>
+#include <utility>
 
 void strelyaev::print(std::istream& in, const Tree< std::string, Tree< int, std::string > >& map, std::ostream& out)
 {
   std::string inner_map_name = "";
   in >> inner_map_name;
-  Tree< int, std::string > inner_map = map.at(inner_map_name);
+  const Tree< int, std::string >& inner_map = map.at(inner_map_name);
   if (inner_map.empty())
   {
     out << "<EMPTY>\n";
@@ -26,16 +27,16 @@ void strelyaev::getComplement(std::istream& in, Tree< std::string, Tree< int, st
   std::string second_name = "";
   in >> new_name >> first_name >> second_name;
   Tree< int, std::string > result;
-  Tree< int, std::string > first = map.at(first_name);
-  Tree< int, std::string > second = map.at(second_name);
+  const Tree< int, std::string >& first = map.at(first_name);
+  const Tree< int, std::string >& second = map.at(second_name);
   for (auto it = first.cbegin(); it != first.cend(); it++)
   {
-    if (second.find(it->first) == second.end())
+    if (second.find(it->first) == second.cend())
     {
       result.insert(*it);
     }
   }
-  map[new_name] = result;
+  map[new_name] = std::move(result);
 }
 
 void strelyaev::getIntersect(std::istream& in, Tree< std::string, Tree< int, std::string > >& map)
@@ -45,16 +46,16 @@ void strelyaev::getIntersect(std::istream& in, Tree< std::string, Tree< int, std
   std::string second_name = "";
   in >> new_name >> first_name >> second_name;
   Tree< int, std::string > result;
-  Tree< int, std::string > first = map.at(first_name);
-  Tree< int, std::string > second = map.at(second_name);
+  const Tree< int, std::string >& first = map.at(first_name);
+  const Tree< int, std::string >& second = map.at(second_name);
   for (auto it = first.cbegin(); it != first.cend(); it++)
   {
-    if (second.find(it->first) != second.end())
+    if (second.find(it->first) != second.cend())
     {
       result.insert(*it);
     }
   }
-  map[new_name] = result;
+  map[new_name] = std::move(result);
 }
 
 void strelyaev::getUnion(std::istream& in, Tree< std::string, Tree< int, std::string > >& map)
@@ -64,8 +65,8 @@ void strelyaev::getUnion(std::istream& in, Tree< std::string, Tree< int, std::st
   std::string second_name = "";
   in >> new_name >> first_name >> second_name;
   Tree< int, std::string > result;
-  Tree< int, std::string > first = map.at(first_name);
-  Tree< int, std::string > second = map.at(second_name);
+  const Tree< int, std::string >& first = map.at(first_name);
+  const Tree< int, std::string >& second = map.at(second_name);
   for (auto it = first.cbegin(); it != first.cend(); it++)
   {
     result.insert(*it);
@@ -77,6 +78,6 @@ void strelyaev::getUnion(std::istream& in, Tree< std::string, Tree< int, std::st
       result.insert(*it);
     }
   }
-  map[new_name] = result;
+  map[new_name] = std::move(result);
 }
 
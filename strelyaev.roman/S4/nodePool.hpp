@@ -0,0 +1,85 @@
+#ifndef NODEPOOL_HPP
+#define NODEPOOL_HPP
+#include <memory>
+#include <cstddef>
+#include "node.hpp"
+
+namespace strelyaev
+{
+  namespace detail
+  {
+    template< typename Key, typename T >
+    class NodePool
+    {
+      using node_t = Node< Key, T >;
+      public:
+        NodePool():
+          free_(nullptr),
+          size_(0)
+        {}
+
+        NodePool(const NodePool&) = delete;
+        NodePool& operator=(const NodePool&) = delete;
+
+        ~NodePool()
+        {
+          while (free_)
+          {
+            node_t* next = free_->right_;
+            delete free_;
+            free_ = next;
+          }
+        }
+
+        static std::shared_ptr< NodePool > shared()
+        {
+          static std::shared_ptr< NodePool > pool = std::make_shared< NodePool >();
+          return pool;
+        }
+
+        node_t* acquire(node_t* left, node_t* parent, node_t* right, const Key& key, const T& value)
+        {
+          if (!free_)
+          {
+            return new node_t(left, parent, right, key, value);
+          }
+          node_t* node = free_;
+          free_ = node->right_;
+          size_--;
+          try
+          {
+            node->data_.first = key;
+            node->data_.second = value;
+          }
+          catch (...)
+          {
+            release(node);
+            throw;
+          }
+          node->left_ = left;
+          node->parent_ = parent;
+          node->right_ = right;
+          node->height_ = 0;
+          return node;
+        }
+
+        void release(node_t* node) noexcept
+        {
+          node->right_ = free_;
+          free_ = node;
+          size_++;
+        }
+
+        size_t size() const noexcept
+        {
+          return size_;
+        }
+
+      private:
+        node_t* free_;
+        size_t size_;
+    };
+  }
+}
+
+#endif
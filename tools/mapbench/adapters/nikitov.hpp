@@ -0,0 +1,30 @@
+#include "tree.hpp"
+
+// Tree::erase calls TreeNode::free, which does not exist, so it cannot be
+// instantiated.
+#define MAPBENCH_NO_ERASE
+
+namespace mapbench
+{
+  using Map = nikitov::Tree< Key, Value >;
+
+  inline void insert_pair(Map & map, const Key & key, Value value)
+  {
+    map.insert(std::make_pair(key, value));
+  }
+
+  inline auto find_key(Map & map, const Key & key)
+  {
+    return map.find(key);
+  }
+
+  inline auto begin_of(Map & map)
+  {
+    return map.begin();
+  }
+
+  inline auto end_of(Map & map)
+  {
+    return map.end();
+  }
+}
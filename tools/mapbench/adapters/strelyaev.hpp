@@ -0,0 +1,28 @@
+#include "binarySearchTree.hpp"
+
+#define MAPBENCH_NO_ERASE
+
+namespace mapbench
+{
+  using Map = strelyaev::Tree< Key, Value >;
+
+  inline void insert_pair(Map & map, const Key & key, Value value)
+  {
+    map.insert(key, value);
+  }
+
+  inline auto find_key(Map & map, const Key & key)
+  {
+    return map.find(key);
+  }
+
+  inline auto begin_of(Map & map)
+  {
+    return map.begin();
+  }
+
+  inline auto end_of(Map & map)
+  {
+    return map.end();
+  }
+}
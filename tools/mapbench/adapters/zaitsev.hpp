@@ -0,0 +1,31 @@
+#include "map.hpp"
+
+namespace mapbench
+{
+  using Map = zaitsev::Map< Key, Value >;
+
+  inline void insert_pair(Map & map, const Key & key, Value value)
+  {
+    map.insert(std::make_pair(key, value));
+  }
+
+  inline auto find_key(Map & map, const Key & key)
+  {
+    return map.find(key);
+  }
+
+  inline auto begin_of(Map & map)
+  {
+    return map.begin();
+  }
+
+  inline auto end_of(Map & map)
+  {
+    return map.end();
+  }
+
+  inline void erase_key(Map & map, const Key & key)
+  {
+    map.erase(key);
+  }
+}
@@ -0,0 +1,31 @@
+#include "binarySearchTree.hpp"
+
+namespace mapbench
+{
+  using Map = zakozhurnikova::BinarySearchTree< Key, Value >;
+
+  inline void insert_pair(Map & map, const Key & key, Value value)
+  {
+    map.push(key, value);
+  }
+
+  inline auto find_key(Map & map, const Key & key)
+  {
+    return map.find(key);
+  }
+
+  inline auto begin_of(Map & map)
+  {
+    return map.cbegin();
+  }
+
+  inline auto end_of(Map & map)
+  {
+    return map.cend();
+  }
+
+  inline void erase_key(Map & map, const Key & key)
+  {
+    map.del(key);
+  }
+}
@@ -0,0 +1,491 @@
+// Ordered map benchmark, built once per implementation by run.py.
+//
+// The adapter header named by MAPBENCH_ADAPTER provides, in namespace
+// mapbench, the type Map keyed by mapbench::Key with mapbench::Value
+// values and the functions insert_pair, find_key, begin_of, end_of and,
+// unless it defines MAPBENCH_NO_ERASE, erase_key. Every run prints a
+// single JSON object to stdout.
+//
+// Usage: mapbench WORKLOAD SIZE OPS SEED ZIPF
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace mapbench
+{
+  // Every comparison a map makes goes through operator< or operator== on
+  // Key, so the calls per successful lookup trace its search path. This is
+  // the tree height proxy reported for every structure, without touching
+  // private members.
+  std::uint64_t compares = 0;
+  std::size_t live_bytes = 0;
+
+  struct Key
+  {
+    long long value;
+  };
+
+  inline bool operator<(const Key & lhs, const Key & rhs)
+  {
+    ++compares;
+    return lhs.value < rhs.value;
+  }
+
+  inline bool operator==(const Key & lhs, const Key & rhs)
+  {
+    ++compares;
+    return lhs.value == rhs.value;
+  }
+
+  using Value = long long;
+}
+
+#include MAPBENCH_ADAPTER
+
+namespace
+{
+  struct alignas(std::max_align_t) AllocHeader
+  {
+    std::size_t size;
+  };
+
+  void * counted_alloc(std::size_t size)
+  {
+    void * block = std::malloc(sizeof(AllocHeader) + size);
+    if (!block)
+    {
+      throw std::bad_alloc();
+    }
+    static_cast< AllocHeader * >(block)->size = size;
+    mapbench::live_bytes += size;
+    return static_cast< AllocHeader * >(block) + 1;
+  }
+
+  void counted_free(void * ptr) noexcept
+  {
+    if (ptr)
+    {
+      AllocHeader * header = static_cast< AllocHeader * >(ptr) - 1;
+      mapbench::live_bytes -= header->size;
+      std::free(header);
+    }
+  }
+}
+
+void * operator new(std::size_t size)
+{
+  return counted_alloc(size);
+}
+
+void * operator new[](std::size_t size)
+{
+  return counted_alloc(size);
+}
+
+void operator delete(void * ptr) noexcept
+{
+  counted_free(ptr);
+}
+
+void operator delete[](void * ptr) noexcept
+{
+  counted_free(ptr);
+}
+
+void operator delete(void * ptr, std::size_t) noexcept
+{
+  counted_free(ptr);
+}
+
+void operator delete[](void * ptr, std::size_t) noexcept
+{
+  counted_free(ptr);
+}
+
+namespace
+{
+  using clock_type = std::chrono::steady_clock;
+  constexpr std::size_t scan_span = 100;
+  constexpr std::size_t copy_rounds = 20;
+
+  // Per-operation samples. Each sample includes one steady_clock::now()
+  // call, so latencies below a few tens of nanoseconds are not meaningful.
+  class Recorder
+  {
+  public:
+    explicit Recorder(std::size_t expected):
+      seconds_(0.0),
+      compares_total_(0),
+      compares_max_(0)
+    {
+      latencies_.reserve(expected);
+    }
+
+    template< class F >
+    void run(F f)
+    {
+      std::uint64_t compares_before = mapbench::compares;
+      clock_type::time_point start = clock_type::now();
+      f();
+      clock_type::time_point finish = clock_type::now();
+      std::uint64_t spent = mapbench::compares - compares_before;
+      compares_total_ += spent;
+      compares_max_ = std::max(compares_max_, spent);
+      std::chrono::duration< double > elapsed = finish - start;
+      seconds_ += elapsed.count();
+      latencies_.push_back(std::chrono::duration_cast< std::chrono::nanoseconds >(finish - start).count());
+    }
+
+    std::size_t ops() const
+    {
+      return latencies_.size();
+    }
+
+    double seconds() const
+    {
+      return seconds_;
+    }
+
+    double compares_mean() const
+    {
+      return latencies_.empty() ? 0.0 : static_cast< double >(compares_total_) / latencies_.size();
+    }
+
+    std::uint64_t compares_max() const
+    {
+      return compares_max_;
+    }
+
+    long long percentile(double fraction)
+    {
+      if (latencies_.empty())
+      {
+        return 0;
+      }
+      std::size_t index = std::min(latencies_.size() - 1, static_cast< std::size_t >(fraction * latencies_.size()));
+      std::nth_element(latencies_.begin(), latencies_.begin() + index, latencies_.end());
+      return latencies_[index];
+    }
+
+  private:
+    std::vector< long long > latencies_;
+    double seconds_;
+    std::uint64_t compares_total_;
+    std::uint64_t compares_max_;
+  };
+
+  struct Report
+  {
+    std::string workload;
+    std::size_t size;
+    double bytes_per_key;
+    bool ok;
+    std::string note;
+  };
+
+  void print(const Report & report, Recorder & recorder)
+  {
+    double seconds = recorder.seconds();
+    long long p50 = recorder.percentile(0.50);
+    long long p99 = recorder.percentile(0.99);
+    std::printf("{\"workload\": \"%s\", \"size\": %zu, \"ops\": %zu, \"seconds\": %.6f, \"ops_per_sec\": %.1f, "
+        "\"p50_ns\": %lld, \"p99_ns\": %lld, \"bytes_per_key\": %.1f, \"compares_mean\": %.2f, "
+        "\"compares_max\": %llu, \"result\": \"%s\"}\n",
+      report.workload.c_str(), report.size, recorder.ops(), seconds,
+      seconds > 0.0 ? recorder.ops() / seconds : 0.0, p50, p99, report.bytes_per_key,
+      recorder.compares_mean(), static_cast< unsigned long long >(recorder.compares_max()),
+      report.ok ? "ok" : (report.note.empty() ? "wrong" : report.note.c_str()));
+  }
+
+  double per_key(std::size_t bytes, std::size_t keys)
+  {
+    return keys ? static_cast< double >(bytes) / keys : 0.0;
+  }
+
+  mapbench::Key make_key(long long value)
+  {
+    return mapbench::Key{ value };
+  }
+
+  bool contains(mapbench::Map & map, long long value)
+  {
+    return mapbench::find_key(map, make_key(value)) != mapbench::end_of(map);
+  }
+
+  // Walks the whole map in order, checking that keys strictly ascend.
+  bool walk(mapbench::Map & map, std::size_t expected)
+  {
+    std::size_t count = 0;
+    bool first = true;
+    long long previous = 0;
+    for (auto it = mapbench::begin_of(map); it != mapbench::end_of(map); ++it)
+    {
+      long long current = (*it).first.value;
+      if (!first && current <= previous)
+      {
+        return false;
+      }
+      first = false;
+      previous = current;
+      ++count;
+    }
+    return count == expected;
+  }
+
+  // Even keys 0, 2, ..., 2 * (size - 1) in random order; odd keys are
+  // guaranteed misses and fresh inserts.
+  std::vector< long long > shuffled_keys(std::size_t size, long long offset, std::mt19937_64 & rng)
+  {
+    std::vector< long long > keys(size);
+    for (std::size_t i = 0; i < size; ++i)
+    {
+      keys[i] = 2 * static_cast< long long >(i) + offset;
+    }
+    std::shuffle(keys.begin(), keys.end(), rng);
+    return keys;
+  }
+
+  std::size_t build(mapbench::Map & map, const std::vector< long long > & keys)
+  {
+    std::size_t before = mapbench::live_bytes;
+    for (long long key: keys)
+    {
+      mapbench::insert_pair(map, make_key(key), key);
+    }
+    return mapbench::live_bytes - before;
+  }
+
+  class Zipf
+  {
+  public:
+    Zipf(std::size_t size, double exponent):
+      cdf_(size)
+    {
+      double sum = 0.0;
+      for (std::size_t i = 0; i < size; ++i)
+      {
+        sum += 1.0 / std::pow(static_cast< double >(i + 1), exponent);
+        cdf_[i] = sum;
+      }
+      for (double & value: cdf_)
+      {
+        value /= sum;
+      }
+    }
+
+    std::size_t operator()(std::mt19937_64 & rng) const
+    {
+      double point = std::uniform_real_distribution< double >(0.0, 1.0)(rng);
+      std::size_t rank = std::lower_bound(cdf_.begin(), cdf_.end(), point) - cdf_.begin();
+      return std::min(rank, cdf_.size() - 1);
+    }
+
+  private:
+    std::vector< double > cdf_;
+  };
+
+  int run_insert(const std::string & name, bool sequential, std::size_t size, std::mt19937_64 & rng)
+  {
+    std::vector< long long > keys = shuffled_keys(size, 0, rng);
+    if (sequential)
+    {
+      std::sort(keys.begin(), keys.end());
+    }
+    mapbench::Map map;
+    Recorder recorder(size);
+    std::size_t before = mapbench::live_bytes;
+    for (long long key: keys)
+    {
+      recorder.run([&map, key]()
+      {
+        mapbench::insert_pair(map, make_key(key), key);
+      });
+    }
+    std::size_t bytes = mapbench::live_bytes - before;
+    print({ name, size, per_key(bytes, size), walk(map, size), "" }, recorder);
+    return 0;
+  }
+
+  int run_lookup(const std::string & name, bool skewed, std::size_t size, std::size_t ops, double exponent,
+    std::mt19937_64 & rng)
+  {
+    std::vector< long long > keys = shuffled_keys(size, 0, rng);
+    mapbench::Map map;
+    std::size_t bytes = build(map, keys);
+    Zipf zipf(skewed ? size : 1, exponent);
+    std::uniform_int_distribution< std::size_t > uniform(0, size - 1);
+    std::size_t hits = 0;
+    Recorder recorder(ops);
+    for (std::size_t i = 0; i < ops; ++i)
+    {
+      long long key = keys[skewed ? zipf(rng) : uniform(rng)];
+      recorder.run([&map, &hits, key]()
+      {
+        hits += contains(map, key);
+      });
+    }
+    print({ name, size, per_key(bytes, size), hits == ops, "" }, recorder);
+    return 0;
+  }
+
+  int run_mixed(const std::string & name, std::size_t size, std::size_t ops, std::mt19937_64 & rng)
+  {
+#ifdef MAPBENCH_NO_ERASE
+    (void) ops;
+    (void) rng;
+    Recorder recorder(0);
+    print({ name, size, 0.0, false, "unsupported" }, recorder);
+    return 0;
+#else
+    std::vector< long long > live = shuffled_keys(size, 0, rng);
+    std::vector< long long > fresh = shuffled_keys(ops, 1, rng);
+    std::size_t next_fresh = 0;
+    mapbench::Map map;
+    std::size_t bytes = build(map, live);
+    std::uniform_int_distribution< int > choice(0, 3);
+    bool ok = true;
+    Recorder recorder(ops);
+    for (std::size_t i = 0; i < ops; ++i)
+    {
+      int kind = live.empty() ? 1 : choice(rng);
+      if (kind == 0 || kind == 2)
+      {
+        std::size_t index = std::uniform_int_distribution< std::size_t >(0, live.size() - 1)(rng);
+        long long key = live[index];
+        bool found = false;
+        recorder.run([&map, &found, key]()
+        {
+          found = contains(map, key);
+        });
+        ok = ok && found;
+      }
+      else if (kind == 1)
+      {
+        long long key = fresh[next_fresh++];
+        live.push_back(key);
+        recorder.run([&map, key]()
+        {
+          mapbench::insert_pair(map, make_key(key), key);
+        });
+      }
+      else
+      {
+        std::size_t index = std::uniform_int_distribution< std::size_t >(0, live.size() - 1)(rng);
+        long long key = live[index];
+        live[index] = live.back();
+        live.pop_back();
+        recorder.run([&map, key]()
+        {
+          mapbench::erase_key(map, make_key(key));
+        });
+      }
+    }
+    ok = ok && walk(map, live.size());
+    print({ name, size, per_key(bytes, size), ok, "" }, recorder);
+    return 0;
+#endif
+  }
+
+  int run_range(const std::string & name, std::size_t size, std::size_t ops, std::mt19937_64 & rng)
+  {
+    std::vector< long long > keys = shuffled_keys(size, 0, rng);
+    mapbench::Map map;
+    std::size_t bytes = build(map, keys);
+    std::uniform_int_distribution< std::size_t > uniform(0, size - 1);
+    bool ok = true;
+    Recorder recorder(ops);
+    for (std::size_t i = 0; i < ops; ++i)
+    {
+      long long start = keys[uniform(rng)];
+      std::size_t expected = std::min(scan_span, static_cast< std::size_t >((2 * static_cast< long long >(size) - start) / 2));
+      std::size_t visited = 0;
+      long long last = start - 2;
+      recorder.run([&map, &visited, &last, start]()
+      {
+        auto it = mapbench::find_key(map, make_key(start));
+        auto end = mapbench::end_of(map);
+        for (; visited < scan_span && it != end; ++it)
+        {
+          last = (*it).first.value;
+          ++visited;
+        }
+      });
+      ok = ok && visited == expected && last == start + 2 * static_cast< long long >(expected - 1);
+    }
+    print({ name, size, per_key(bytes, size), ok, "" }, recorder);
+    return 0;
+  }
+
+  int run_copy(const std::string & name, std::size_t size, std::mt19937_64 & rng)
+  {
+    std::vector< long long > keys = shuffled_keys(size, 0, rng);
+    mapbench::Map map;
+    std::size_t bytes = build(map, keys);
+    bool ok = true;
+    Recorder recorder(copy_rounds);
+    for (std::size_t i = 0; i < copy_rounds; ++i)
+    {
+      mapbench::Map * copy = nullptr;
+      recorder.run([&map, &copy]()
+      {
+        copy = new mapbench::Map(map);
+      });
+      ok = ok && walk(*copy, size);
+      delete copy;
+    }
+    print({ name, size, per_key(bytes, size), ok, "" }, recorder);
+    return 0;
+  }
+}
+
+int main(int argc, char ** argv)
+{
+  if (argc != 6)
+  {
+    std::fprintf(stderr, "Usage: %s WORKLOAD SIZE OPS SEED ZIPF\n", argv[0]);
+    return 2;
+  }
+  std::string workload = argv[1];
+  std::size_t size = std::strtoull(argv[2], nullptr, 10);
+  std::size_t ops = std::strtoull(argv[3], nullptr, 10);
+  std::mt19937_64 rng(std::strtoull(argv[4], nullptr, 10));
+  double exponent = std::strtod(argv[5], nullptr);
+  if (size == 0)
+  {
+    std::fprintf(stderr, "SIZE must be positive\n");
+    return 2;
+  }
+  if (workload == "seq_insert" || workload == "rand_insert")
+  {
+    return run_insert(workload, workload == "seq_insert", size, rng);
+  }
+  else if (workload == "rand_lookup" || workload == "zipf_lookup")
+  {
+    return run_lookup(workload, workload == "zipf_lookup", size, ops, exponent, rng);
+  }
+  else if (workload == "mixed")
+  {
+    return run_mixed(workload, size, ops, rng);
+  }
+  else if (workload == "range")
+  {
+    return run_range(workload, size, ops, rng);
+  }
+  else if (workload == "copy")
+  {
+    return run_copy(workload, size, rng);
+  }
+  std::fprintf(stderr, "Unknown workload %s\n", workload.c_str());
+  return 2;
+}
@@ -0,0 +1,138 @@
+#!/usr/bin/env python3
+"""Benchmarks the students' ordered maps against each other.
+
+Each implementation is compiled once from mapbench.cpp with its adapter
+from adapters/ into out/mapbench/<name>. Every (implementation,
+workload) pair runs in a fresh process, so a crash, a hang or a wrong
+answer in one map only spoils its own row.
+
+Workloads (SIZE keys, OPS operations):
+  seq_insert   SIZE inserts in ascending key order
+  rand_insert  SIZE inserts in random order
+  rand_lookup  OPS uniform lookups of present keys
+  zipf_lookup  OPS lookups of present keys with Zipf(--zipf) popularity
+  mixed        OPS operations: 50% lookup, 25% insert, 25% erase
+  range        OPS scans of 100 consecutive keys from a random key
+  copy         20 copy constructions of a SIZE-key map
+
+Reported per row: ops/sec, p50 and p99 latency of a single operation
+(each sample includes one steady_clock read), heap bytes per key taken
+while building the map, and the mean and max number of key comparisons
+per operation. On the lookup workloads compares_max is the deepest
+search path, which stands in for the tree height: it is measured the
+same way for every structure, and a 2-3 node costs up to two
+comparisons per level. "result" is ok, wrong (lost keys or bad
+order), unsupported (no erase), crashed, timeout or build-failed.
+
+Example (from the repository root):
+  tools/mapbench/run.py
+  tools/mapbench/run.py --impl erohin --impl zaitsev --size 1000000 --json
+"""
+
+import argparse
+import json
+import os
+import signal
+import subprocess
+import sys
+
+IMPLEMENTATIONS = {
+  'erohin': ['erohin.vladimir/common'],
+  'zaitsev': ['zaitsev.vladimir/common'],
+  'namestnikov': ['namestnikov.kirill/common'],
+  'gladyshev': ['gladyshev.matvey/S4', 'gladyshev.matvey/common'],
+  'strelyaev': ['strelyaev.roman/S4', 'strelyaev.roman/common'],
+  'zakozhurnikova': ['zakozhurnikova.kristina/common'],
+  'piyavkin': ['piyavkin.anton/common'],
+  'zhalilov': ['zhalilov.rail/common'],
+  'zhalilov_btree': ['zhalilov.rail/common'],
+  'nikitov': ['nikitov.dmitriy/common'],
+}
+
+WORKLOADS = ['seq_insert', 'rand_insert', 'rand_lookup', 'zipf_lookup', 'mixed', 'range', 'copy']
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+
+
+def build(root, name, cxx, cxxflags):
+  output_dir = os.path.join(root, 'out', 'mapbench')
+  os.makedirs(output_dir, exist_ok=True)
+  binary = os.path.join(output_dir, name)
+  command = [cxx, '-std=c++14'] + cxxflags.split()
+  command += ['-I' + os.path.join(root, include) for include in IMPLEMENTATIONS[name]]
+  command += ['-DMAPBENCH_ADAPTER="{}"'.format(os.path.join(HERE, 'adapters', name + '.hpp'))]
+  command += ['-o', binary, os.path.join(HERE, 'mapbench.cpp')]
+  result = subprocess.run(command, stdout=subprocess.DEVNULL, stderr=subprocess.PIPE)
+  if result.returncode != 0:
+    sys.stderr.write('[{}] build failed:\n{}\n'.format(name, result.stderr.decode(errors='replace')))
+    return None
+  return binary
+
+
+def run(binary, workload, args):
+  command = [binary, workload, str(args.size), str(args.ops), str(args.seed), str(args.zipf)]
+  try:
+    result = subprocess.run(command, stdin=subprocess.DEVNULL, stdout=subprocess.PIPE,
+      stderr=subprocess.DEVNULL, timeout=args.timeout)
+  except subprocess.TimeoutExpired:
+    return {'workload': workload, 'result': 'timeout'}
+  if result.returncode != 0:
+    if result.returncode < 0:
+      reason = signal.Signals(-result.returncode).name
+    else:
+      reason = 'exit {}'.format(result.returncode)
+    return {'workload': workload, 'result': 'crashed', 'reason': reason}
+  return json.loads(result.stdout.decode())
+
+
+def print_row(row):
+  if 'ops_per_sec' not in row or row['result'] == 'unsupported':
+    print('{:<16} {:<12} {:>12} {:>10} {:>10} {:>8} {:>8} {:>12}'.format(row['impl'], row['workload'],
+      '-', '-', '-', '-', '-', row['result']))
+    return
+  print('{:<16} {:<12} {:>12.0f} {:>10} {:>10.1f} {:>8.1f} {:>8} {:>12}'.format(row['impl'], row['workload'],
+    row['ops_per_sec'], row['p99_ns'], row['bytes_per_key'], row['compares_mean'], row['compares_max'],
+    row['result']))
+
+
+def main():
+  parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+  parser.add_argument('--root', default='.', help='repository root')
+  parser.add_argument('--impl', action='append', dest='impls', choices=sorted(IMPLEMENTATIONS),
+    help='implementation to run, repeatable, default: all')
+  parser.add_argument('--workload', action='append', dest='workloads', choices=WORKLOADS,
+    help='workload to run, repeatable, default: all')
+  parser.add_argument('--size', type=int, default=100000, help='keys in the map')
+  parser.add_argument('--ops', type=int, default=200000, help='operations for lookup, mixed and range')
+  parser.add_argument('--seed', type=int, default=1)
+  parser.add_argument('--zipf', type=float, default=0.99, help='Zipf exponent for zipf_lookup')
+  parser.add_argument('--timeout', type=float, default=60.0, help='seconds per run')
+  parser.add_argument('--cxx', default=os.environ.get('CXX', 'g++'))
+  parser.add_argument('--cxxflags', default='-O2 -DNDEBUG')
+  parser.add_argument('--json', action='store_true', help='print one JSON object per run')
+  args = parser.parse_args()
+
+  root = os.path.abspath(args.root)
+  impls = args.impls or list(IMPLEMENTATIONS)
+  workloads = args.workloads or WORKLOADS
+  if not args.json:
+    print('{:<16} {:<12} {:>12} {:>10} {:>10} {:>8} {:>8} {:>12}'.format('impl', 'workload', 'ops/sec',
+      'p99 ns', 'B/key', 'cmp avg', 'cmp max', 'result'))
+  for name in impls:
+    binary = build(root, name, args.cxx, args.cxxflags)
+    for workload in workloads:
+      if binary is None:
+        row = {'workload': workload, 'result': 'build-failed'}
+      else:
+        row = run(binary, workload, args)
+      row['impl'] = name
+      if args.json:
+        print(json.dumps(row), flush=True)
+      else:
+        print_row(row)
+        sys.stdout.flush()
+  return 0
+
+
+if __name__ == '__main__':
+  sys.exit(main())
@@ -0,0 +1,229 @@
+#!/usr/bin/env python3
+"""Deterministic infix expression workload generator for S2 calculators.
+
+Writes one expression per line to OUTPUT and the reference result to
+OUTPUT.expected. The first line of the expected file is either "ok",
+followed by the exact stdout the lab must print, or "error" when the
+lab must fail with a non-zero exit status. A single overflowing or
+malformed line makes the whole file an "error" workload, so keep
+--overflow-rate and --invalid-rate at zero for throughput runs.
+
+Example:
+  generate.py --lines 100000 --length 16 --depth 4 --seed 1 big.txt
+"""
+
+import argparse
+import random
+import sys
+
+LLONG_MAX = 2 ** 63 - 1
+LLONG_MIN = -2 ** 63
+PRIORITY = {'+': 1, '-': 1, '*': 2, '/': 2, '%': 2}
+
+
+class EvalError(Exception):
+  pass
+
+
+class Rejected(Exception):
+  """Line is valid but outside what the workload asked for."""
+
+
+def check_range(value):
+  if value < LLONG_MIN or value > LLONG_MAX:
+    raise EvalError('overflow')
+  return value
+
+
+def apply(op, lhs, rhs, non_negative):
+  if op == '+':
+    result = check_range(lhs + rhs)
+  elif op == '-':
+    result = check_range(lhs - rhs)
+  elif op == '*':
+    result = check_range(lhs * rhs)
+  elif rhs == 0:
+    raise EvalError('division by zero')
+  elif lhs < 0 or rhs < 0:
+    # labs disagree on the sign of / and % for negative operands
+    raise Rejected()
+  else:
+    result = lhs // rhs if op == '/' else lhs % rhs
+  if non_negative and result < 0:
+    raise Rejected()
+  return result
+
+
+def evaluate(tokens, non_negative=False):
+  """Reference shunting-yard evaluator over signed 64-bit integers."""
+  output = []
+  operators = []
+
+  def reduce_top():
+    op = operators.pop()
+    if len(output) < 2:
+      raise EvalError('missing operand')
+    rhs = output.pop()
+    output.append(apply(op, output.pop(), rhs, non_negative))
+
+  expect_operand = True
+  for token in tokens:
+    if token == '(':
+      if not expect_operand:
+        raise EvalError('unexpected bracket')
+      operators.append(token)
+    elif token == ')':
+      if expect_operand:
+        raise EvalError('unexpected bracket')
+      while operators and operators[-1] != '(':
+        reduce_top()
+      if not operators:
+        raise EvalError('unbalanced brackets')
+      operators.pop()
+    elif token in PRIORITY:
+      if expect_operand:
+        raise EvalError('unexpected operator')
+      while operators and operators[-1] != '(' and PRIORITY[operators[-1]] >= PRIORITY[token]:
+        reduce_top()
+      operators.append(token)
+      expect_operand = True
+      continue
+    else:
+      if not expect_operand or not token.isdigit():
+        raise EvalError('bad operand')
+      output.append(check_range(int(token)))
+    expect_operand = token == '('
+  if expect_operand:
+    raise EvalError('missing operand')
+  while operators:
+    if operators[-1] == '(':
+      raise EvalError('unbalanced brackets')
+    reduce_top()
+  return output[0]
+
+
+class Generator:
+  def __init__(self, args):
+    self.rng = random.Random(args.seed)
+    self.length = args.length
+    self.depth = args.depth
+    self.max_operand = args.max_operand
+    self.bracket_rate = args.bracket_rate
+    self.non_negative = args.non_negative
+    self.ops, self.weights = parse_mix(args.mix)
+
+  def operand(self):
+    return [str(self.rng.randint(0, self.max_operand))]
+
+  def tree(self, ops_left):
+    if ops_left == 0:
+      return self.operand(), None
+    op = self.rng.choices(self.ops, self.weights)[0]
+    left_ops = self.rng.randint(0, ops_left - 1)
+    left, left_op = self.tree(left_ops)
+    right, right_op = self.tree(ops_left - 1 - left_ops)
+    left = self.wrap(left, left_op, op, False)
+    right = self.wrap(right, right_op, op, True)
+    return left + [op] + right, op
+
+  def wrap(self, tokens, child_op, op, is_right):
+    if child_op is None:
+      return tokens
+    needed = PRIORITY[child_op] < PRIORITY[op] or (is_right and PRIORITY[child_op] == PRIORITY[op])
+    if (needed or self.rng.random() < self.bracket_rate) and nesting(tokens) < self.depth:
+      return ['('] + tokens + [')']
+    return tokens
+
+  def valid(self):
+    while True:
+      tokens, _ = self.tree(self.rng.randint(self.length // 2, self.length))
+      try:
+        return tokens, evaluate(tokens, self.non_negative)
+      except (EvalError, Rejected):
+        continue
+
+  def overflow(self):
+    tokens, value = self.valid()
+    if value >= 1:
+      return ['('] + tokens + [')', '+', str(LLONG_MAX - value + 1)]
+    return [str(LLONG_MAX), '+', str(self.rng.randint(1, self.max_operand + 1)), '+', '('] + tokens + [')']
+
+  def invalid(self):
+    tokens, _ = self.valid()
+    kind = self.rng.randrange(4)
+    if kind == 0:
+      return tokens + [self.rng.choice(self.ops)]
+    if kind == 1:
+      return ['('] + tokens
+    if kind == 2:
+      return tokens + [')']
+    position = self.rng.randrange(len(tokens) + 1)
+    return tokens[:position] + ['x'] + tokens[position:]
+
+
+def nesting(tokens):
+  depth = 0
+  result = 0
+  for token in tokens:
+    if token == '(':
+      depth += 1
+      result = max(result, depth)
+    elif token == ')':
+      depth -= 1
+  return result
+
+
+def parse_mix(mix):
+  ops = []
+  weights = []
+  for item in mix.split(','):
+    op, _, weight = item.partition('=')
+    if op not in PRIORITY:
+      raise SystemExit('unknown operator in --mix: ' + op)
+    ops.append(op)
+    weights.append(float(weight) if weight else 1.0)
+  return ops, weights
+
+
+def main():
+  parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+  parser.add_argument('output')
+  parser.add_argument('--lines', type=int, default=1000)
+  parser.add_argument('--length', type=int, default=8, help='maximum operators per line')
+  parser.add_argument('--depth', type=int, default=3, help='maximum bracket nesting')
+  parser.add_argument('--bracket-rate', type=float, default=0.2, help='chance of redundant brackets')
+  parser.add_argument('--mix', default='+=4,-=4,*=2,/=1,%=1', help='operator weights')
+  parser.add_argument('--max-operand', type=int, default=1000)
+  parser.add_argument('--overflow-rate', type=float, default=0.0)
+  parser.add_argument('--invalid-rate', type=float, default=0.0)
+  parser.add_argument('--non-negative', action='store_true', help='keep every intermediate result >= 0')
+  parser.add_argument('--seed', type=int, default=0)
+  args = parser.parse_args()
+
+  generator = Generator(args)
+  results = []
+  failed = False
+  with open(args.output, 'w') as out:
+    for _ in range(args.lines):
+      roll = generator.rng.random()
+      if roll < args.overflow_rate:
+        tokens = generator.overflow()
+      elif roll < args.overflow_rate + args.invalid_rate:
+        tokens = generator.invalid()
+      else:
+        tokens = generator.valid()[0]
+      try:
+        results.append(evaluate(tokens))
+      except (EvalError, Rejected):
+        failed = True
+      out.write(' '.join(tokens) + '\n')
+  with open(args.output + '.expected', 'w') as expected:
+    if failed:
+      expected.write('error\n')
+    else:
+      expected.write('ok\n' + ' '.join(str(value) for value in reversed(results)) + '\n')
+  return 0
+
+
+if __name__ == '__main__':
+  sys.exit(main())
@@ -0,0 +1,169 @@
+#!/usr/bin/env python3
+"""Runs S2 calculators over generated workloads and compares them.
+
+Every out/<labid>/lab is started with the workload file as its only
+argument. Wall time is taken over --repeat runs (best run wins), peak
+RSS is sampled from /proc/<pid>/status (Linux only), and the result is
+checked against the .expected file written by generate.py. Runs that
+finish within one polling interval report no RSS.
+
+Example (from the repository root, after "make build-<labid>"):
+  tools/s2bench/run.py big.txt errors.txt
+  tools/s2bench/run.py --lab erohin.vladimir/S2 --json big.txt
+"""
+
+import argparse
+import glob
+import json
+import os
+import signal
+import subprocess
+import sys
+import tempfile
+import threading
+import time
+
+
+def find_labs(root):
+  labs = []
+  for binary in sorted(glob.glob(os.path.join(root, 'out', '*', 'S2', 'lab'))):
+    labs.append(os.path.relpath(os.path.dirname(binary), os.path.join(root, 'out')))
+  return labs
+
+
+def read_expected(workload):
+  with open(workload + '.expected') as expected:
+    status = expected.readline().strip()
+    return status, expected.read()
+
+
+def count_lines(workload):
+  with open(workload, 'rb') as data:
+    return sum(1 for line in data if line.strip())
+
+
+def measure(binary, workload, repeat, timeout):
+  best = None
+  for _ in range(repeat):
+    result = run_with_usage(binary, workload, timeout)
+    if result is None:
+      return None
+    if best is None or result['seconds'] < best['seconds']:
+      best = result
+  return best
+
+
+def read_peak_rss(pid):
+  try:
+    with open('/proc/{}/status'.format(pid)) as status:
+      for line in status:
+        if line.startswith('VmHWM:'):
+          return int(line.split()[1])
+  except OSError:
+    pass
+  return None
+
+
+class RssSampler(threading.Thread):
+  """Polls VmHWM of a running child.
+
+  rusage from wait4 is useless here: its ru_maxrss already holds the
+  resident size of this interpreter at the moment of fork. VmHWM is
+  reset by exec and only grows, so the last sample misses at most the
+  growth during the final polling interval.
+  """
+
+  def __init__(self, pid, interval):
+    super().__init__(daemon=True)
+    self.pid = pid
+    self.interval = interval
+    self.peak = None
+    self.done = threading.Event()
+
+  def run(self):
+    while not self.done.is_set():
+      value = read_peak_rss(self.pid)
+      if value is not None:
+        self.peak = max(self.peak or 0, value)
+      self.done.wait(self.interval)
+
+
+def run_with_usage(binary, workload, timeout):
+  with tempfile.TemporaryFile() as output:
+    start = time.perf_counter()
+    process = subprocess.Popen([binary, workload], stdin=subprocess.DEVNULL, stdout=output, stderr=subprocess.DEVNULL)
+    sampler = RssSampler(process.pid, 0.0005)
+    sampler.start()
+    killer = threading.Timer(timeout, process.kill)
+    killer.start()
+    # WNOWAIT leaves the zombie in place so the sampler never reads a reused pid
+    os.waitid(os.P_PID, process.pid, os.WEXITED | os.WNOWAIT)
+    elapsed = time.perf_counter() - start
+    killer.cancel()
+    sampler.done.set()
+    sampler.join()
+    process.wait()
+    if process.returncode == -signal.SIGKILL and elapsed >= timeout:
+      return None
+    output.seek(0)
+    return {
+      'seconds': elapsed,
+      'exit_code': process.returncode,
+      'stdout': output.read().decode(errors='replace'),
+      'peak_rss_kib': sampler.peak,
+    }
+
+
+def check(result, expected_status, expected_stdout):
+  if expected_status == 'error':
+    return result['exit_code'] != 0
+  return result['exit_code'] == 0 and result['stdout'] == expected_stdout
+
+
+def main():
+  parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+  parser.add_argument('workloads', nargs='+')
+  parser.add_argument('--root', default='.', help='repository root containing out/')
+  parser.add_argument('--lab', action='append', dest='labs', help='labid to run, repeatable, default: every built */S2')
+  parser.add_argument('--repeat', type=int, default=3)
+  parser.add_argument('--timeout', type=float, default=60.0)
+  parser.add_argument('--json', action='store_true', help='print one JSON object per run')
+  args = parser.parse_args()
+
+  labs = args.labs or find_labs(args.root)
+  if not labs:
+    sys.stderr.write('No built S2 labs under ' + os.path.join(args.root, 'out') + '\n')
+    return 1
+  if not args.json:
+    print('{:<28} {:<20} {:>12} {:>10} {:>8}'.format('lab', 'workload', 'lines/sec', 'rss KiB', 'result'))
+  for workload in args.workloads:
+    expected_status, expected_stdout = read_expected(workload)
+    lines = count_lines(workload)
+    for lab in labs:
+      binary = os.path.abspath(os.path.join(args.root, 'out', lab, 'lab'))
+      result = measure(binary, workload, args.repeat, args.timeout)
+      if result is None:
+        row = {'lab': lab, 'workload': workload, 'result': 'timeout'}
+      else:
+        row = {
+          'lab': lab,
+          'workload': workload,
+          'lines': lines,
+          'seconds': result['seconds'],
+          'lines_per_sec': lines / result['seconds'] if result['seconds'] > 0 else 0.0,
+          'peak_rss_kib': result['peak_rss_kib'],
+          'exit_code': result['exit_code'],
+          'result': 'ok' if check(result, expected_status, expected_stdout) else 'wrong',
+        }
+      if args.json:
+        print(json.dumps(row))
+      elif result is None:
+        print('{:<28} {:<20} {:>12} {:>10} {:>8}'.format(lab, os.path.basename(workload), '-', '-', 'timeout'))
+      else:
+        print('{:<28} {:<20} {:>12.0f} {:>10} {:>8}'.format(lab, os.path.basename(workload),
+          row['lines_per_sec'], '-' if row['peak_rss_kib'] is None else row['peak_rss_kib'], row['result']))
+  return 0
+
+
+if __name__ == '__main__':
+  sys.exit(main())
@@ -0,0 +1,128 @@
+#!/usr/bin/env python3
+"""Profiles nikitov::Tree traversals with hardware counters.
+
+travprof.cpp is compiled once against nikitov.dmitriy/common into
+out/travprof/travprof. Every (traversal, size) pair then runs in a fresh
+process, so a slow or broken traversal only spoils its own row. Each run
+builds a tree of SIZE shuffled keys and times one of traverseLNR,
+traverseRNL or traverseBreadth over REPS passes.
+
+Reported per row, averaged over the passes and divided by the number of
+nodes: nanoseconds, cycles, instructions, L1d read misses, last level
+cache misses, branch misses, and calls to operator new. The IPC column
+is instructions per cycle over the whole pass. Counters come from
+perf_event_open (Linux only). They need a PMU and
+kernel.perf_event_paranoid <= 2. A counter the kernel refuses is shown
+as '-', while time and allocations are always measured. "result" is ok,
+wrong (a node was missed or visited twice), crashed or timeout.
+
+Example (from the repository root):
+  tools/travprof/run.py
+  tools/travprof/run.py --traversal lnr --size 1000000 --reps 20 --json
+"""
+
+import argparse
+import json
+import os
+import signal
+import subprocess
+import sys
+
+INCLUDES = ['nikitov.dmitriy/common']
+
+TRAVERSALS = ['lnr', 'rnl', 'breadth']
+
+DEFAULT_SIZES = [1000, 10000, 100000, 1000000]
+
+COLUMNS = [
+  ('ns_per_node', 'ns'),
+  ('cycles_per_node', 'cycles'),
+  ('instructions_per_node', 'instr'),
+  ('ipc', 'ipc'),
+  ('l1d_misses_per_node', 'L1d miss'),
+  ('llc_misses_per_node', 'LLC miss'),
+  ('branch_misses_per_node', 'br miss'),
+  ('allocations_per_node', 'allocs'),
+]
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+
+
+def build(root, cxx, cxxflags):
+  output_dir = os.path.join(root, 'out', 'travprof')
+  os.makedirs(output_dir, exist_ok=True)
+  binary = os.path.join(output_dir, 'travprof')
+  command = [cxx, '-std=c++14'] + cxxflags.split()
+  command += ['-I' + os.path.join(root, include) for include in INCLUDES]
+  command += ['-o', binary, os.path.join(HERE, 'travprof.cpp')]
+  result = subprocess.run(command, stdout=subprocess.DEVNULL, stderr=subprocess.PIPE)
+  if result.returncode != 0:
+    sys.stderr.write('build failed:\n{}\n'.format(result.stderr.decode(errors='replace')))
+    return None
+  return binary
+
+
+def run(binary, traversal, size, args):
+  command = [binary, traversal, str(size), str(args.reps), str(args.seed)]
+  try:
+    result = subprocess.run(command, stdin=subprocess.DEVNULL, stdout=subprocess.PIPE,
+      stderr=subprocess.DEVNULL, timeout=args.timeout)
+  except subprocess.TimeoutExpired:
+    return {'traversal': traversal, 'size': size, 'result': 'timeout'}
+  if result.returncode != 0:
+    if result.returncode < 0:
+      reason = signal.Signals(-result.returncode).name
+    else:
+      reason = 'exit {}'.format(result.returncode)
+    return {'traversal': traversal, 'size': size, 'result': 'crashed', 'reason': reason}
+  return json.loads(result.stdout.decode())
+
+
+def cell(value):
+  return '-' if value is None else '{:.3f}'.format(value)
+
+
+def print_row(row):
+  line = '{:<10} {:>9}'.format(row['traversal'], row['size'])
+  for key, _ in COLUMNS:
+    line += ' {:>9}'.format(cell(row.get(key)))
+  print(line + ' {:>8}'.format(row['result']))
+
+
+def main():
+  parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+  parser.add_argument('--root', default='.', help='repository root')
+  parser.add_argument('--traversal', action='append', dest='traversals', choices=TRAVERSALS,
+    help='traversal to run, repeatable, default: all')
+  parser.add_argument('--size', type=int, action='append', dest='sizes',
+    help='nodes in the tree, repeatable, default: 1e3 to 1e6')
+  parser.add_argument('--reps', type=int, default=10, help='timed passes per traversal')
+  parser.add_argument('--seed', type=int, default=1)
+  parser.add_argument('--timeout', type=float, default=60.0, help='seconds per run')
+  parser.add_argument('--cxx', default=os.environ.get('CXX', 'g++'))
+  parser.add_argument('--cxxflags', default='-O2 -DNDEBUG')
+  parser.add_argument('--json', action='store_true', help='print one JSON object per row')
+  args = parser.parse_args()
+
+  binary = build(os.path.abspath(args.root), args.cxx, args.cxxflags)
+  if binary is None:
+    return 1
+  if not args.json:
+    header = '{:<10} {:>9}'.format('traversal', 'size')
+    for _, title in COLUMNS:
+      header += ' {:>9}'.format(title)
+    print(header + ' {:>8}'.format('result'))
+    print('{:<10} {:>9}'.format('', '') + ' {:>9}'.format('per node') * len(COLUMNS))
+  for size in args.sizes or DEFAULT_SIZES:
+    for traversal in args.traversals or TRAVERSALS:
+      row = run(binary, traversal, size, args)
+      if args.json:
+        print(json.dumps(row), flush=True)
+      else:
+        print_row(row)
+        sys.stdout.flush()
+  return 0
+
+
+if __name__ == '__main__':
+  sys.exit(main())
@@ -0,0 +1,338 @@
+// Hardware counter profile of nikitov::Tree traversals, built by run.py.
+//
+// Builds a Tree< int, long long > of SIZE shuffled keys and runs one of
+// traverseLNR, traverseRNL or traverseBreadth REPS times, after one
+// untimed warm-up pass. Around every timed pass it reads cycles,
+// instructions, L1d read misses, last level cache misses and branch
+// misses through perf_event_open, and counts calls to operator new.
+// Prints one JSON object with totals averaged over REPS and the same
+// figures divided by SIZE.
+//
+// Counters the kernel refuses (no PMU in a VM, perf_event_paranoid too
+// high, no such event on this CPU) are reported as null; time and
+// allocations are always measured. Counters the kernel had to
+// multiplex are scaled by time enabled / time running.
+//
+// Usage: travprof lnr|rnl|breadth SIZE REPS SEED
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <tree.hpp>
+
+namespace travprof
+{
+  std::uint64_t allocations = 0;
+  std::uint64_t allocated_bytes = 0;
+}
+
+namespace
+{
+  void * counted_alloc(std::size_t size)
+  {
+    ++travprof::allocations;
+    travprof::allocated_bytes += size;
+    void * block = std::malloc(size ? size : 1);
+    if (!block)
+    {
+      throw std::bad_alloc();
+    }
+    return block;
+  }
+}
+
+void * operator new(std::size_t size)
+{
+  return counted_alloc(size);
+}
+
+void * operator new[](std::size_t size)
+{
+  return counted_alloc(size);
+}
+
+void operator delete(void * ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete[](void * ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete(void * ptr, std::size_t) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete[](void * ptr, std::size_t) noexcept
+{
+  std::free(ptr);
+}
+
+namespace
+{
+  using clock_type = std::chrono::steady_clock;
+  using tree_type = nikitov::Tree< int, long long >;
+
+  struct EventSpec
+  {
+    const char * name;
+    std::uint32_t type;
+    std::uint64_t config;
+  };
+
+  constexpr std::uint64_t cache_event(std::uint64_t cache, std::uint64_t op, std::uint64_t result)
+  {
+    return cache | (op << 8) | (result << 16);
+  }
+
+  const EventSpec event_specs[] = {
+    { "cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+    { "instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+    { "l1d_misses", PERF_TYPE_HW_CACHE,
+      cache_event(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS) },
+    { "llc_misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+    { "branch_misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES }
+  };
+  constexpr std::size_t event_count = sizeof(event_specs) / sizeof(event_specs[0]);
+
+  // One file descriptor per event rather than a group: a group is only
+  // scheduled when all of its events fit on the PMU at once, and a CPU
+  // that lacks one cache event would then lose every counter.
+  class Counters
+  {
+  public:
+    Counters()
+    {
+      for (std::size_t i = 0; i < event_count; ++i)
+      {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = event_specs[i].type;
+        attr.config = event_specs[i].config;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        fds_[i] = static_cast< int >(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+      }
+    }
+
+    Counters(const Counters &) = delete;
+    Counters & operator=(const Counters &) = delete;
+
+    ~Counters()
+    {
+      for (int fd: fds_)
+      {
+        if (fd >= 0)
+        {
+          close(fd);
+        }
+      }
+    }
+
+    void start()
+    {
+      for (int fd: fds_)
+      {
+        if (fd >= 0)
+        {
+          ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+          ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+      }
+    }
+
+    void stop()
+    {
+      for (int fd: fds_)
+      {
+        if (fd >= 0)
+        {
+          ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        }
+      }
+    }
+
+    // Adds the scaled count of every event to totals; an event that could
+    // not be opened or read, or never ran, is marked unavailable.
+    void accumulate(double * totals, bool * available) const
+    {
+      for (std::size_t i = 0; i < event_count; ++i)
+      {
+        std::uint64_t values[3] = { 0, 0, 0 };
+        if (fds_[i] < 0 || read(fds_[i], values, sizeof(values)) != static_cast< ssize_t >(sizeof(values))
+          || values[2] == 0)
+        {
+          available[i] = false;
+          continue;
+        }
+        totals[i] += static_cast< double >(values[0]) * values[1] / values[2];
+      }
+    }
+
+  private:
+    int fds_[event_count];
+  };
+
+  // Keeps the traversal from being optimised away and checks it visited
+  // every node once.
+  struct Visitor
+  {
+    long long sum;
+    std::size_t count;
+
+    void operator()(const std::pair< int, long long > & value)
+    {
+      sum += value.second;
+      ++count;
+    }
+  };
+
+  using traversal_type = Visitor (*)(const tree_type &);
+
+  Visitor traverse_lnr(const tree_type & tree)
+  {
+    return tree.traverseLNR(Visitor{ 0, 0 });
+  }
+
+  Visitor traverse_rnl(const tree_type & tree)
+  {
+    return tree.traverseRNL(Visitor{ 0, 0 });
+  }
+
+  Visitor traverse_breadth(const tree_type & tree)
+  {
+    return tree.traverseBreadth(Visitor{ 0, 0 });
+  }
+
+  void print_value(const char * name, double total, bool available, std::size_t size)
+  {
+    if (available)
+    {
+      std::printf(", \"%s\": %.1f, \"%s_per_node\": %.3f", name, total, name, size ? total / size : 0.0);
+    }
+    else
+    {
+      std::printf(", \"%s\": null, \"%s_per_node\": null", name, name);
+    }
+  }
+
+  void profile(const char * name, traversal_type traversal, const tree_type & tree, std::size_t size,
+    std::size_t reps, long long expected_sum)
+  {
+    Counters counters;
+    double totals[event_count] = {};
+    bool available[event_count];
+    std::fill(available, available + event_count, true);
+    double seconds = 0.0;
+    std::uint64_t allocations = 0;
+    std::uint64_t allocated_bytes = 0;
+    bool ok = true;
+
+    Visitor warm_up = traversal(tree);
+    ok = ok && warm_up.count == size && warm_up.sum == expected_sum;
+    for (std::size_t rep = 0; rep < reps; ++rep)
+    {
+      std::uint64_t allocations_before = travprof::allocations;
+      std::uint64_t bytes_before = travprof::allocated_bytes;
+      clock_type::time_point start = clock_type::now();
+      counters.start();
+      Visitor visitor = traversal(tree);
+      counters.stop();
+      clock_type::time_point finish = clock_type::now();
+      std::chrono::duration< double > elapsed = finish - start;
+      seconds += elapsed.count();
+      allocations += travprof::allocations - allocations_before;
+      allocated_bytes += travprof::allocated_bytes - bytes_before;
+      counters.accumulate(totals, available);
+      ok = ok && visitor.count == size && visitor.sum == expected_sum;
+    }
+
+    double runs = reps ? static_cast< double >(reps) : 1.0;
+    double nanoseconds = seconds * 1e9 / runs;
+    std::printf("{\"traversal\": \"%s\", \"size\": %zu, \"reps\": %zu, \"ns\": %.1f, \"ns_per_node\": %.3f",
+      name, size, reps, nanoseconds, size ? nanoseconds / size : 0.0);
+    for (std::size_t i = 0; i < event_count; ++i)
+    {
+      print_value(event_specs[i].name, totals[i] / runs, available[i], size);
+    }
+    if (available[0] && available[1] && totals[0] > 0.0)
+    {
+      std::printf(", \"ipc\": %.3f", totals[1] / totals[0]);
+    }
+    else
+    {
+      std::printf(", \"ipc\": null");
+    }
+    print_value("allocations", allocations / runs, true, size);
+    print_value("allocated_bytes", allocated_bytes / runs, true, size);
+    std::printf(", \"result\": \"%s\"}\n", ok ? "ok" : "wrong");
+    std::fflush(stdout);
+  }
+}
+
+int main(int argc, char ** argv)
+{
+  if (argc != 5)
+  {
+    std::fprintf(stderr, "Usage: travprof lnr|rnl|breadth SIZE REPS SEED\n");
+    return 2;
+  }
+  std::string name = argv[1];
+  traversal_type traversal = nullptr;
+  if (name == "lnr")
+  {
+    traversal = traverse_lnr;
+  }
+  else if (name == "rnl")
+  {
+    traversal = traverse_rnl;
+  }
+  else if (name == "breadth")
+  {
+    traversal = traverse_breadth;
+  }
+  else
+  {
+    std::fprintf(stderr, "Unknown traversal: %s\n", name.c_str());
+    return 2;
+  }
+  std::size_t size = std::strtoull(argv[2], nullptr, 10);
+  std::size_t reps = std::strtoull(argv[3], nullptr, 10);
+  std::mt19937_64 rng(std::strtoull(argv[4], nullptr, 10));
+
+  std::vector< int > keys(size);
+  for (std::size_t i = 0; i < size; ++i)
+  {
+    keys[i] = static_cast< int >(i);
+  }
+  std::shuffle(keys.begin(), keys.end(), rng);
+  tree_type tree;
+  long long expected_sum = 0;
+  for (int key: keys)
+  {
+    tree.insert(std::make_pair(key, static_cast< long long >(key)));
+    expected_sum += key;
+  }
+
+  profile(name.c_str(), traversal, tree, size, reps, expected_sum);
+  return 0;
+}
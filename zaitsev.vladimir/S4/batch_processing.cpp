@@ -0,0 +1,301 @@
+#include "batch_processing.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <forward_list.hpp>
+#include <map.hpp>
+#include <work_stealing_pool.hpp>
+
+namespace
+{
+  using namespace zaitsev;
+
+  enum class CommandKind
+  {
+    print,
+    complement,
+    intersect,
+    unite,
+    invalid
+  };
+
+  struct Command
+  {
+    CommandKind kind;
+    std::string target;
+    std::string ds1;
+    std::string ds2;
+  };
+
+  struct Task
+  {
+    Command command;
+    std::string output;
+    std::exception_ptr error;
+    std::atomic< size_t > pending;
+    ForwardList< size_t > successors;
+    bool done;
+
+    Task():
+      command{ CommandKind::invalid, "", "", "" },
+      pending(0),
+      done(false)
+    {}
+  };
+
+  // Who last wrote a dataset name and who has read it since.
+  struct NameUsage
+  {
+    size_t writer;
+    ForwardList< size_t > readers;
+  };
+
+  const size_t no_writer = std::numeric_limits< size_t >::max();
+
+  // Consumes the stream exactly like the interactive loop in main does.
+  PseudoDeque< Command > readScript(std::istream& in)
+  {
+    PseudoDeque< Command > script;
+    while (in)
+    {
+      std::string name;
+      in >> name;
+      if (!in)
+      {
+        break;
+      }
+      Command command{ CommandKind::invalid, "", "", "" };
+      if (name == "print")
+      {
+        command.kind = CommandKind::print;
+        in >> command.ds1;
+      }
+      else if (name == "complement" || name == "intersect" || name == "union")
+      {
+        command.kind = name == "complement" ? CommandKind::complement :
+          (name == "intersect" ? CommandKind::intersect : CommandKind::unite);
+        in >> command.target >> command.ds1 >> command.ds2;
+      }
+      script.push_back(std::move(command));
+      in.ignore(std::numeric_limits< std::streamsize >::max(), '\n');
+    }
+    return script;
+  }
+
+  void addEdge(Task* tasks, size_t from, size_t to)
+  {
+    if (from == to || (!tasks[from].successors.empty() && tasks[from].successors.front() == to))
+    {
+      return;
+    }
+    tasks[from].successors.push_front(to);
+    tasks[to].pending.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void addRead(Task* tasks, Map< std::string, NameUsage >& usage, const std::string& name, size_t index)
+  {
+    auto it = usage.find(name);
+    if (it == usage.end())
+    {
+      usage.insert(std::make_pair(name, NameUsage{ no_writer, ForwardList< size_t >{ index } }));
+      return;
+    }
+    if (it->second.writer != no_writer)
+    {
+      addEdge(tasks, it->second.writer, index);
+    }
+    it->second.readers.push_front(index);
+  }
+
+  void addWrite(Task* tasks, Map< std::string, NameUsage >& usage, const std::string& name, size_t index)
+  {
+    auto it = usage.find(name);
+    if (it == usage.end())
+    {
+      usage.insert(std::make_pair(name, NameUsage{ index, ForwardList< size_t >() }));
+      return;
+    }
+    if (it->second.writer != no_writer)
+    {
+      addEdge(tasks, it->second.writer, index);
+    }
+    for (auto reader = it->second.readers.cbegin(); reader != it->second.readers.cend(); ++reader)
+    {
+      addEdge(tasks, *reader, index);
+    }
+    it->second.writer = index;
+    it->second.readers.clear();
+  }
+
+  class BatchRunner
+  {
+  public:
+    BatchRunner(Task* tasks, library& lib, size_t threads):
+      tasks_(tasks),
+      lib_(lib),
+      pool_(threads)
+    {}
+
+    void schedule(size_t index)
+    {
+      pool_.submit([this, index]()
+      {
+        execute(index);
+      });
+    }
+
+    void wait(size_t index)
+    {
+      std::unique_lock< std::mutex > lock(done_mutex_);
+      finished_.wait(lock, [this, index]()
+      {
+        return tasks_[index].done;
+      });
+    }
+
+  private:
+    Task* tasks_;
+    library& lib_;
+    std::mutex lib_mutex_;
+    std::mutex done_mutex_;
+    std::condition_variable finished_;
+    // Declared last: its destructor runs the remaining tasks, which still
+    // use the members above.
+    WorkStealingPool pool_;
+
+    // Only lookups and stores touch the library under the lock; the inputs
+    // are O(1) snapshots, so the set operations themselves run unlocked.
+    bool fetch(const std::string& name, dictionary& dest)
+    {
+      std::lock_guard< std::mutex > lock(lib_mutex_);
+      auto it = lib_.find(name);
+      if (it == lib_.end())
+      {
+        return false;
+      }
+      dest = it->second.snapshot();
+      return true;
+    }
+
+    void store(const std::string& name, dictionary& value)
+    {
+      std::lock_guard< std::mutex > lock(lib_mutex_);
+      std::swap(lib_[name], value);
+    }
+
+    void run(Task& task)
+    {
+      const Command& command = task.command;
+      dictionary ds1;
+      dictionary ds2;
+      if (command.kind == CommandKind::invalid || !fetch(command.ds1, ds1))
+      {
+        throw std::invalid_argument("<INVALID COMMAND>");
+      }
+      if (command.kind == CommandKind::print)
+      {
+        std::ostringstream out;
+        printDict(out, command.ds1, ds1);
+        task.output = out.str();
+        return;
+      }
+      if (!fetch(command.ds2, ds2))
+      {
+        throw std::invalid_argument("<INVALID COMMAND>");
+      }
+      dictionary result;
+      if (command.kind == CommandKind::complement)
+      {
+        result = complementDicts(ds1, ds2);
+      }
+      else if (command.kind == CommandKind::intersect)
+      {
+        result = intersectDicts(ds1, ds2);
+      }
+      else
+      {
+        result = uniteDicts(ds1, ds2);
+      }
+      store(command.target, result);
+    }
+
+    void execute(size_t index)
+    {
+      Task& task = tasks_[index];
+      try
+      {
+        run(task);
+      }
+      catch (const std::invalid_argument&)
+      {
+        task.output = "<INVALID COMMAND>\n";
+      }
+      catch (...)
+      {
+        task.error = std::current_exception();
+      }
+      for (auto it = task.successors.cbegin(); it != task.successors.cend(); ++it)
+      {
+        if (tasks_[*it].pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+          schedule(*it);
+        }
+      }
+      {
+        std::lock_guard< std::mutex > lock(done_mutex_);
+        task.done = true;
+      }
+      finished_.notify_one();
+    }
+  };
+}
+
+void zaitsev::runBatch(std::istream& in, std::ostream& out, library& lib, size_t threads)
+{
+  PseudoDeque< Command > script = readScript(in);
+  size_t count = script.size();
+  std::unique_ptr< Task[] > tasks(new Task[count]);
+  Map< std::string, NameUsage > usage;
+  for (size_t i = 0; i < count; ++i)
+  {
+    Task& task = tasks[i];
+    task.command = std::move(script.front());
+    script.pop_front();
+    if (task.command.kind == CommandKind::invalid)
+    {
+      continue;
+    }
+    addRead(tasks.get(), usage, task.command.ds1, i);
+    if (task.command.kind != CommandKind::print)
+    {
+      addRead(tasks.get(), usage, task.command.ds2, i);
+      addWrite(tasks.get(), usage, task.command.target, i);
+    }
+  }
+  PseudoDeque< size_t > ready;
+  for (size_t i = 0; i < count; ++i)
+  {
+    if (tasks[i].pending.load(std::memory_order_relaxed) == 0)
+    {
+      ready.push_back(i);
+    }
+  }
+  BatchRunner runner(tasks.get(), lib, threads);
+  for (; !ready.empty(); ready.pop_front())
+  {
+    runner.schedule(ready.front());
+  }
+  for (size_t i = 0; i < count; ++i)
+  {
+    runner.wait(i);
+    if (tasks[i].error)
+    {
+      std::rethrow_exception(tasks[i].error);
+    }
+    out << tasks[i].output;
+  }
+}
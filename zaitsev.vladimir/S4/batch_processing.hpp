@@ -0,0 +1,14 @@
+#ifndef BATCH_PROCESSING_HPP
+#define BATCH_PROCESSING_HPP
+#include <iostream>
+#include "commands_processing.hpp"
+
+namespace zaitsev
+{
+  // Reads the whole command script first, then runs every command as soon
+  // as the commands before it that touch the same dataset names are done.
+  // Output is printed in script order and matches running the script
+  // command by command.
+  void runBatch(std::istream& in, std::ostream& out, library& lib, size_t threads);
+}
+#endif
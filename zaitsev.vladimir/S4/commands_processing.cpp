@@ -16,7 +16,7 @@
     while (in.peek() != '\n' && in)
     {
       in >> key >> value;
-      new_dict[key] = value;
+      new_dict.insert_or_assign(key, value);
     }
     dest[name] = std::move(new_dict);
   }
@@ -38,77 +38,50 @@
     }
   }
 
-  void zaitsev::printDs(std::istream& in, library& lib)
+  void zaitsev::printDict(std::ostream& out, const std::string& name, const dictionary& dict)
   {
-    std::string ds_name;
-    in >> ds_name;
-    if (!lib.count(ds_name))
+    if (dict.empty())
     {
-      throw std::invalid_argument("<INVALID COMMAND>");
-    }
-    if (lib.at(ds_name).empty())
-    {
-      std::cout << "<EMPTY>\n";
+      out << "<EMPTY>\n";
       return;
     }
-    std::cout << ds_name;
-    for (auto i : lib.at(ds_name))
+    out << name;
+    for (ds_it i = dict.cbegin(); i != dict.cend(); ++i)
     {
-      std::cout << " " << i.first << " " << i.second;
+      out << " " << (*i).first << " " << (*i).second;
     }
-    std::cout << '\n';
+    out << '\n';
   }
 
-  void zaitsev::complementDs(std::istream& in, library& lib)
+  zaitsev::dictionary zaitsev::complementDicts(const dictionary& ds1, const dictionary& ds2)
   {
-    std::string new_ds_name, ds1_name, ds2_name;
-    in >> new_ds_name >> ds1_name >> ds2_name;
-    if (!lib.count(ds1_name) || !lib.count(ds2_name))
-    {
-      throw std::invalid_argument("<INVALID COMMAND>");
-    }
-    ds_it ds1_beg = lib[ds1_name].cbegin();
-    ds_it ds2_beg = lib[ds2_name].cbegin();
-    ds_it ds1_end = lib[ds1_name].cend();
-    ds_it ds2_end = lib[ds2_name].cend();
-    dictionary new_dict;
+    ds_it ds1_beg = ds1.cbegin();
+    ds_it ds2_beg = ds2.cbegin();
+    ds_it ds1_end = ds1.cend();
+    ds_it ds2_end = ds2.cend();
+    dictionary new_dict = ds1.snapshot();
     while (ds1_beg != ds1_end && ds2_beg != ds2_end)
     {
       if ((*ds1_beg).first == (*ds2_beg).first)
       {
+        new_dict.erase((*ds1_beg).first);
         ++ds1_beg;
         ++ds2_beg;
       }
-      else if ((*ds1_beg).first < (*ds2_beg).first)
-      {
-        new_dict.insert(*ds1_beg);
-        ++ds1_beg;
-      }
       else
       {
-        ++ds2_beg;
+        (*ds1_beg).first < (*ds2_beg).first ? ++ds1_beg : ++ds2_beg;
       }
     }
-    while (ds1_beg != ds1_end)
-    {
-      new_dict.insert(*ds1_beg);
-      ++ds1_beg;
-    }
-    lib[new_ds_name] = std::move(new_dict);
+    return new_dict;
   }
 
-  void zaitsev::intersectDs(std::istream& in, library& lib)
+  zaitsev::dictionary zaitsev::intersectDicts(const dictionary& ds1, const dictionary& ds2)
   {
-    std::string new_ds_name, ds1_name, ds2_name;
-    in >> new_ds_name >> ds1_name >> ds2_name;
-    if (!lib.count(ds1_name) || !lib.count(ds2_name))
-    {
-      throw std::invalid_argument("<INVALID COMMAND>");
-    }
-    ds_it ds1_beg = lib[ds1_name].cbegin();
-    ds_it ds2_beg = lib[ds2_name].cbegin();
-    ds_it ds1_end = lib[ds1_name].end();
-    ds_it ds2_end = lib[ds2_name].end();
+    ds_it ds1_beg = ds1.cbegin();
+    ds_it ds2_beg = ds2.cbegin();
+    ds_it ds1_end = ds1.cend();
+    ds_it ds2_end = ds2.cend();
     dictionary new_dict;
     while (ds1_beg != ds1_end && ds2_beg != ds2_end)
     {
@@ -123,33 +96,25 @@
         (*ds1_beg).first < (*ds2_beg).first ? ++ds1_beg : ++ds2_beg;
       }
     }
-    lib[new_ds_name] = std::move(new_dict);
+    return new_dict;
   }
 
-  void zaitsev::uniteDs(std::istream& in, library& lib)
+  zaitsev::dictionary zaitsev::uniteDicts(const dictionary& ds1, const dictionary& ds2)
   {
-    std::string new_ds_name, ds1_name, ds2_name;
-    in >> new_ds_name >> ds1_name >> ds2_name;
-    if (!lib.count(ds1_name) || !lib.count(ds2_name))
-    {
-      throw std::invalid_argument("<INVALID COMMAND>");
-    }
-    ds_it ds1_beg = lib[ds1_name].cbegin();
-    ds_it ds2_beg = lib[ds2_name].cbegin();
-    ds_it ds1_end = lib[ds1_name].end();
-    ds_it ds2_end = lib[ds2_name].end();
-    dictionary new_dict;
+    ds_it ds1_beg = ds1.cbegin();
+    ds_it ds2_beg = ds2.cbegin();
+    ds_it ds1_end = ds1.cend();
+    ds_it ds2_end = ds2.cend();
+    dictionary new_dict = ds1.snapshot();
     while (ds1_beg != ds1_end && ds2_beg != ds2_end)
     {
       if ((*ds1_beg).first == (*ds2_beg).first)
       {
-        new_dict.insert(*ds1_beg);
         ++ds1_beg;
         ++ds2_beg;
       }
       else if ((*ds1_beg).first < (*ds2_beg).first)
       {
-        new_dict.insert(*ds1_beg);
         ++ds1_beg;
       }
       else
@@ -158,15 +123,57 @@
         ++ds2_beg;
       }
     }
-    while (ds1_beg != ds1_end)
-    {
-      new_dict.insert(*ds1_beg);
-      ++ds1_beg;
-    }
     while (ds2_beg != ds2_end)
     {
       new_dict.insert(*ds2_beg);
       ++ds2_beg;
     }
+    return new_dict;
+  }
+
+  void zaitsev::printDs(std::istream& in, library& lib)
+  {
+    std::string ds_name;
+    in >> ds_name;
+    if (!lib.count(ds_name))
+    {
+      throw std::invalid_argument("<INVALID COMMAND>");
+    }
+    printDict(std::cout, ds_name, lib.at(ds_name));
+  }
+
+  void zaitsev::complementDs(std::istream& in, library& lib)
+  {
+    std::string new_ds_name, ds1_name, ds2_name;
+    in >> new_ds_name >> ds1_name >> ds2_name;
+    if (!lib.count(ds1_name) || !lib.count(ds2_name))
+    {
+      throw std::invalid_argument("<INVALID COMMAND>");
+    }
+    dictionary new_dict = complementDicts(lib[ds1_name], lib[ds2_name]);
+    lib[new_ds_name] = std::move(new_dict);
+  }
+
+  void zaitsev::intersectDs(std::istream& in, library& lib)
+  {
+    std::string new_ds_name, ds1_name, ds2_name;
+    in >> new_ds_name >> ds1_name >> ds2_name;
+    if (!lib.count(ds1_name) || !lib.count(ds2_name))
+    {
+      throw std::invalid_argument("<INVALID COMMAND>");
+    }
+    dictionary new_dict = intersectDicts(lib[ds1_name], lib[ds2_name]);
+    lib[new_ds_name] = std::move(new_dict);
+  }
+
+  void zaitsev::uniteDs(std::istream& in, library& lib)
+  {
+    std::string new_ds_name, ds1_name, ds2_name;
+    in >> new_ds_name >> ds1_name >> ds2_name;
+    if (!lib.count(ds1_name) || !lib.count(ds2_name))
+    {
+      throw std::invalid_argument("<INVALID COMMAND>");
+    }
+    dictionary new_dict = uniteDicts(lib[ds1_name], lib[ds2_name]);
     lib[new_ds_name] = std::move(new_dict);
   }
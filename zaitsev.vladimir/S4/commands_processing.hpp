@@ -3,15 +3,20 @@
 #include <iostream>
 #include <string>
 #include <map.hpp>
+#include <persistent_map.hpp>
 
 namespace zaitsev
 {
-  using dictionary = zaitsev::Map< int, std::string >;
-  using ds_it = zaitsev::Map< int, std::string >::const_iterator;
+  using dictionary = zaitsev::PersistentMap< int, std::string >;
+  using ds_it = dictionary::const_iterator;
   using library = zaitsev::Map< std::string, dictionary >;
 
   void initLib(int argc, char** argv, library& dest);
   void readDs(std::istream& in, library& dest);
+  void printDict(std::ostream& out, const std::string& name, const dictionary& dict);
+  dictionary complementDicts(const dictionary& ds1, const dictionary& ds2);
+  dictionary intersectDicts(const dictionary& ds1, const dictionary& ds2);
+  dictionary uniteDicts(const dictionary& ds1, const dictionary& ds2);
   void printDs(std::istream& in, library& lib);
   void complementDs(std::istream& in, library& lib);
   void intersectDs(std::istream& in, library& lib);
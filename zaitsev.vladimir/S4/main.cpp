@@ -2,8 +2,10 @@
 #include <fstream>
 #include <limits>
 #include <string>
+#include <thread>
 #include <map.hpp>
 #include "commands_processing.hpp"
+#include "batch_processing.hpp"
 
 int main(int argc, char** argv)
 {
@@ -12,6 +14,11 @@ int main(int argc, char** argv)
   try
   {
     initLib(argc, argv, lib);
+    if (argc > 2 && std::string(argv[2]) == "--batch")
+    {
+      runBatch(std::cin, std::cout, lib, std::thread::hardware_concurrency());
+      return 0;
+    }
     zaitsev::Map< std::string, void(*)(std::istream&, library&) > commands;
     commands["print"] = printDs;
     commands["intersect"] = intersectDs;
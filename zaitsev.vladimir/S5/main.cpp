@@ -3,10 +3,16 @@
 #include <string>
 #include <functional>
 #include <stdexcept>
+#include <thread>
 #include <operators.hpp>
 #include <map.hpp>
 #include "summator.hpp"
 
+namespace
+{
+  const size_t parallel_cutoff = 1 << 14;
+}
+
 int main(int argc, char** argv)
 {
   if (argc != 3)
@@ -37,10 +43,25 @@ int main(int argc, char** argv)
     {
       Map< std::string, std::function< summator()> > commands;
       using ll = long long;
-      commands["ascending"] = std::bind(&Map< ll, std::string >::traverse_lnr< summator >, &key_vals, summator{});
-      commands["descending"] = std::bind(&Map< ll, std::string >::traverse_rnl< summator >, &key_vals, summator{});
+      size_t threads = std::thread::hardware_concurrency();
+      commands["ascending"] = std::bind(&Map< ll, std::string >::parallel_traverse_lnr< summator >, &key_vals, summator{},
+          threads, parallel_cutoff);
+      commands["descending"] = std::bind(&Map< ll, std::string >::parallel_traverse_rnl< summator >, &key_vals, summator{},
+          threads, parallel_cutoff);
       commands["breadth"] = std::bind(&Map< ll, std::string >::traverse_breadth< summator >, &key_vals, summator{});
-      summator res = commands.at(argv[1])();
+      summator res;
+      try
+      {
+        res = commands.at(argv[1])();
+      }
+      catch (const std::runtime_error&)
+      {
+        // A part can overflow on its own while the whole running sum stays
+        // in range; only the sequential pass decides.
+        commands["ascending"] = std::bind(&Map< ll, std::string >::traverse_lnr< summator >, &key_vals, summator{});
+        commands["descending"] = std::bind(&Map< ll, std::string >::traverse_rnl< summator >, &key_vals, summator{});
+        res = commands.at(argv[1])();
+      }
       std::cout << res.key_sum << " " << res.val_sum << '\n';
     }
   }
@@ -1,8 +1,27 @@
 #include "summator.hpp"
+#include <algorithm>
 #include <operators.hpp>
 
 void zaitsev::summator::operator()(const std::pair< const long long, std::string >& key_value)
 {
   key_sum = safePlus(key_sum, key_value.first);
-  val_sum += (val_sum.empty() ? key_value.second : " " + key_value.second);
+  max_prefix = std::max(max_prefix, key_sum);
+  min_prefix = std::min(min_prefix, key_sum);
+  if (!val_sum.empty())
+  {
+    val_sum += ' ';
+  }
+  val_sum += key_value.second;
+}
+
+void zaitsev::summator::merge(const summator& tail)
+{
+  max_prefix = std::max(max_prefix, safePlus(key_sum, tail.max_prefix));
+  min_prefix = std::min(min_prefix, safePlus(key_sum, tail.min_prefix));
+  key_sum = safePlus(key_sum, tail.key_sum);
+  if (!val_sum.empty() && !tail.val_sum.empty())
+  {
+    val_sum += ' ';
+  }
+  val_sum += tail.val_sum;
 }
@@ -7,7 +7,13 @@ namespace zaitsev
   struct summator
   {
     void operator()(const std::pair< const long long, std::string >& key_value);
+    void merge(const summator& tail);
     long long key_sum = 0;
+    // Extremes of the running sum, relative to where this part starts;
+    // merge() uses them to find an overflow that a sequential pass
+    // would hit part way through.
+    long long max_prefix = 0;
+    long long min_prefix = 0;
     std::string val_sum = "";
   };
 }
@@ -111,6 +111,23 @@ namespace zaitsev
     {
       emplace_back(std::move(value));
     }
+    // The list is singly linked, so finding the new tail is linear.
+    void pop_back()
+    {
+      if (size_ == 1)
+      {
+        pop_front();
+        return;
+      }
+      list_tail prev = list_.cbegin();
+      for (size_t i = 2; i < size_; ++i)
+      {
+        ++prev;
+      }
+      list_.erase_after(prev);
+      tail_ = prev;
+      --size_;
+    }
 
     void clear()
     {
@@ -128,7 +145,7 @@ namespace zaitsev
     }
     T& back()
     {
-      return *tail_;
+      return const_cast< T& >(*tail_);
     }
     const T& back() const
     {
@@ -1,9 +1,11 @@
 #ifndef MAP_HPP
 #define MAP_HPP
 #include <algorithm>
+#include <exception>
 #include <initializer_list>
 #include <memory>
 #include <stdexcept>
+#include <thread>
 #include <stack.hpp>
 #include <queue.hpp>
 
@@ -223,6 +225,61 @@ namespace zaitsev
       }
       return;
     }
+    template< class F >
+    static void foldSubtree(const Node* root, F& f, bool reverse)
+    {
+      if (!root)
+      {
+        return;
+      }
+      foldSubtree(reverse ? root->right_ : root->left_, f, reverse);
+      f(root->val_);
+      foldSubtree(reverse ? root->left_ : root->right_, f, reverse);
+    }
+    template< class F >
+    static void reduceSubtree(const Node* root, F& f, size_t threads, size_t cutoff, bool reverse)
+    {
+      if (!root)
+      {
+        return;
+      }
+      bool small = root->height_ < 62 && (size_t(2) << root->height_) <= cutoff;
+      if (threads < 2 || small)
+      {
+        foldSubtree(root, f, reverse);
+        return;
+      }
+      F tail;
+      std::exception_ptr tail_error;
+      size_t tail_threads = threads / 2;
+      std::thread worker([&]()
+      {
+        try
+        {
+          reduceSubtree(reverse ? root->left_ : root->right_, tail, tail_threads, cutoff, reverse);
+        }
+        catch (...)
+        {
+          tail_error = std::current_exception();
+        }
+      });
+      try
+      {
+        reduceSubtree(reverse ? root->right_ : root->left_, f, threads - tail_threads, cutoff, reverse);
+        f(root->val_);
+      }
+      catch (...)
+      {
+        worker.join();
+        throw;
+      }
+      worker.join();
+      if (tail_error)
+      {
+        std::rethrow_exception(tail_error);
+      }
+      f.merge(tail);
+    }
     void freeNodes(Node* root) noexcept
     {
       if (!root)
@@ -820,6 +877,29 @@ namespace zaitsev
       }
       return f;
     }
+    // Same order as the sequential traversals, but the tree is split at its
+    // upper levels: the far subtree of a node is reduced on a new thread
+    // into a default constructed F, then appended with f.merge(tail).
+    // Subtrees of at most cutoff nodes are folded sequentially. Exceptions
+    // are rethrown in traversal order.
+    template< class F >
+    F parallel_traverse_lnr(F f, size_t threads = std::thread::hardware_concurrency(), size_t cutoff = 1 << 14) const
+    {
+      if (size_)
+      {
+        reduceSubtree(fakeroot_->left_, f, threads, cutoff, false);
+      }
+      return f;
+    }
+    template< class F >
+    F parallel_traverse_rnl(F f, size_t threads = std::thread::hardware_concurrency(), size_t cutoff = 1 << 14) const
+    {
+      if (size_)
+      {
+        reduceSubtree(fakeroot_->left_, f, threads, cutoff, true);
+      }
+      return f;
+    }
     template< class F >
     F traverse_breadth(F f)
     {
@@ -0,0 +1,555 @@
+#ifndef PERSISTENT_MAP_HPP
+#define PERSISTENT_MAP_HPP
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <queue.hpp>
+
+namespace zaitsev
+{
+  // AVL tree whose nodes are shared between versions. Copying a map or taking
+  // a snapshot only bumps the reference count of the root; an update copies
+  // the shared nodes on its root-to-leaf path and modifies uniquely owned ones
+  // in place. Counters are atomic, so different versions may be read and
+  // updated from different threads.
+  template< typename Key, typename T, typename Compare = std::less< Key > >
+  class PersistentMap
+  {
+    using val_t = std::pair< const Key, T >;
+    struct Node
+    {
+      val_t val_;
+      int height_;
+      Node* left_;
+      Node* right_;
+      std::atomic< size_t > refs_;
+
+      template< class... Args >
+      explicit Node(Args&&... args):
+        val_(std::forward< Args >(args)...),
+        height_(0),
+        left_(nullptr),
+        right_(nullptr),
+        refs_(1)
+      {}
+      static int depth(const Node* node)
+      {
+        return node ? node->height_ + 1 : 0;
+      }
+      void updateHeight()
+      {
+        height_ = std::max(depth(left_), depth(right_));
+      }
+    };
+    // AVL height never exceeds 1.45 * log2(n + 2), so this fits any size_t
+    static constexpr size_t max_height = 96;
+
+    Compare comparator_;
+    Node* root_;
+    size_t size_;
+
+    static Node* retain(Node* node) noexcept
+    {
+      if (node)
+      {
+        node->refs_.fetch_add(1, std::memory_order_relaxed);
+      }
+      return node;
+    }
+    static void release(Node* node) noexcept
+    {
+      if (node && node->refs_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+      {
+        release(node->left_);
+        release(node->right_);
+        delete node;
+      }
+    }
+    static void detach(Node*& slot)
+    {
+      if (slot->refs_.load(std::memory_order_acquire) == 1)
+      {
+        return;
+      }
+      Node* copy = new Node(slot->val_);
+      copy->height_ = slot->height_;
+      copy->left_ = retain(slot->left_);
+      copy->right_ = retain(slot->right_);
+      release(slot);
+      slot = copy;
+    }
+    static void rotateLeft(Node*& slot)
+    {
+      detach(slot->right_);
+      Node* new_root = slot->right_;
+      slot->right_ = new_root->left_;
+      new_root->left_ = slot;
+      slot->updateHeight();
+      new_root->updateHeight();
+      slot = new_root;
+    }
+    static void rotateRight(Node*& slot)
+    {
+      detach(slot->left_);
+      Node* new_root = slot->left_;
+      slot->left_ = new_root->right_;
+      new_root->right_ = slot;
+      slot->updateHeight();
+      new_root->updateHeight();
+      slot = new_root;
+    }
+    static void rebalance(Node*& slot)
+    {
+      int depth_diff = Node::depth(slot->left_) - Node::depth(slot->right_);
+      if (depth_diff > 1)
+      {
+        if (Node::depth(slot->left_->left_) < Node::depth(slot->left_->right_))
+        {
+          detach(slot->left_);
+          rotateLeft(slot->left_);
+        }
+        rotateRight(slot);
+      }
+      else if (depth_diff < -1)
+      {
+        if (Node::depth(slot->right_->right_) < Node::depth(slot->right_->left_))
+        {
+          detach(slot->right_);
+          rotateRight(slot->right_);
+        }
+        rotateLeft(slot);
+      }
+      else
+      {
+        slot->updateHeight();
+      }
+    }
+    const Node* findNode(const Key& key) const
+    {
+      const Node* cur = root_;
+      while (cur)
+      {
+        if (comparator_(key, cur->val_.first))
+        {
+          cur = cur->left_;
+        }
+        else if (comparator_(cur->val_.first, key))
+        {
+          cur = cur->right_;
+        }
+        else
+        {
+          return cur;
+        }
+      }
+      return nullptr;
+    }
+    // Each of the helpers below returns whether the height of the subtree has
+    // changed, so balancing stops at the first level that is not affected
+    template< class V >
+    bool addNode(Node*& slot, V&& new_val)
+    {
+      if (!slot)
+      {
+        slot = new Node(std::forward< V >(new_val));
+        return true;
+      }
+      detach(slot);
+      bool changed = false;
+      if (comparator_(new_val.first, slot->val_.first))
+      {
+        changed = addNode(slot->left_, std::forward< V >(new_val));
+      }
+      else if (comparator_(slot->val_.first, new_val.first))
+      {
+        changed = addNode(slot->right_, std::forward< V >(new_val));
+      }
+      else
+      {
+        slot->val_.second = std::forward< V >(new_val).second;
+      }
+      return changed && balance(slot);
+    }
+    static bool extractMin(Node*& slot, Node*& min)
+    {
+      detach(slot);
+      if (!slot->left_)
+      {
+        min = slot;
+        slot = min->right_;
+        min->right_ = nullptr;
+        return true;
+      }
+      return extractMin(slot->left_, min) && balance(slot);
+    }
+    bool eraseNode(Node*& slot, const Key& key)
+    {
+      detach(slot);
+      if (comparator_(key, slot->val_.first))
+      {
+        return eraseNode(slot->left_, key) && balance(slot);
+      }
+      else if (comparator_(slot->val_.first, key))
+      {
+        return eraseNode(slot->right_, key) && balance(slot);
+      }
+      Node* for_del = slot;
+      bool changed = true;
+      if (!for_del->left_ || !for_del->right_)
+      {
+        slot = for_del->left_ ? for_del->left_ : for_del->right_;
+      }
+      else
+      {
+        changed = extractMin(for_del->right_, slot);
+        slot->left_ = for_del->left_;
+        slot->right_ = for_del->right_;
+        slot->height_ = for_del->height_;
+        changed = changed && balance(slot);
+      }
+      for_del->left_ = nullptr;
+      for_del->right_ = nullptr;
+      release(for_del);
+      return changed;
+    }
+    static bool balance(Node*& slot)
+    {
+      int old_height = slot->height_;
+      rebalance(slot);
+      return slot->height_ != old_height;
+    }
+
+    template< bool Reverse >
+    class BaseIterator
+    {
+      template< typename T1, typename T2, class T3 > friend class PersistentMap;
+
+      const Node* root_;
+      const Node* path_[max_height];
+      size_t depth_;
+
+      explicit BaseIterator(const Node* root) noexcept:
+        root_(root),
+        depth_(0)
+      {}
+      const Node* top() const
+      {
+        return path_[depth_ - 1];
+      }
+      void fall(const Node* node, bool to_left)
+      {
+        for (; node; node = to_left ? node->left_ : node->right_)
+        {
+          path_[depth_++] = node;
+        }
+      }
+      void step(bool to_right)
+      {
+        if (!depth_)
+        {
+          fall(root_, to_right);
+          return;
+        }
+        const Node* next = to_right ? top()->right_ : top()->left_;
+        if (next)
+        {
+          fall(next, to_right);
+          return;
+        }
+        const Node* cur = top();
+        --depth_;
+        while (depth_ && (to_right ? top()->right_ : top()->left_) == cur)
+        {
+          cur = top();
+          --depth_;
+        }
+      }
+    public:
+      using iterator_category = std::bidirectional_iterator_tag;
+      using value_type = const val_t;
+      using difference_type = std::ptrdiff_t;
+      using pointer = const val_t*;
+      using reference = const val_t&;
+
+      BaseIterator() noexcept:
+        root_(nullptr),
+        depth_(0)
+      {}
+      BaseIterator(const BaseIterator& other) noexcept:
+        root_(other.root_),
+        depth_(other.depth_)
+      {
+        std::copy(other.path_, other.path_ + depth_, path_);
+      }
+      BaseIterator& operator=(const BaseIterator& other) noexcept
+      {
+        root_ = other.root_;
+        depth_ = other.depth_;
+        std::copy(other.path_, other.path_ + depth_, path_);
+        return *this;
+      }
+      BaseIterator& operator++()
+      {
+        step(!Reverse);
+        return *this;
+      }
+      BaseIterator operator++(int)
+      {
+        BaseIterator copy = *this;
+        ++(*this);
+        return copy;
+      }
+      BaseIterator& operator--()
+      {
+        step(Reverse);
+        return *this;
+      }
+      BaseIterator operator--(int)
+      {
+        BaseIterator copy = *this;
+        --(*this);
+        return copy;
+      }
+      reference operator*() const
+      {
+        return top()->val_;
+      }
+      pointer operator->() const
+      {
+        return std::addressof(top()->val_);
+      }
+      bool operator!=(const BaseIterator& other) const noexcept
+      {
+        return !(*this == other);
+      }
+      bool operator==(const BaseIterator& other) const noexcept
+      {
+        return depth_ == other.depth_ && (!depth_ || top() == other.top());
+      }
+    };
+  public:
+    // Iterators stay valid as long as the version they were taken from is
+    // alive, whatever happens to the other versions
+    using const_iterator = BaseIterator< false >;
+    using const_rnl_iterator = BaseIterator< true >;
+
+    PersistentMap():
+      comparator_(),
+      root_(nullptr),
+      size_(0)
+    {}
+    PersistentMap(const PersistentMap& other) noexcept:
+      comparator_(other.comparator_),
+      root_(retain(other.root_)),
+      size_(other.size_)
+    {}
+    PersistentMap(PersistentMap&& other) noexcept:
+      comparator_(std::move(other.comparator_)),
+      root_(other.root_),
+      size_(other.size_)
+    {
+      other.root_ = nullptr;
+      other.size_ = 0;
+    }
+    PersistentMap(std::initializer_list< val_t > init_list):
+      PersistentMap()
+    {
+      for (const val_t& val: init_list)
+      {
+        insert(val);
+      }
+    }
+    ~PersistentMap()
+    {
+      release(root_);
+    }
+    PersistentMap& operator=(const PersistentMap& other) noexcept
+    {
+      PersistentMap copy(other);
+      swap(copy);
+      return *this;
+    }
+    PersistentMap& operator=(PersistentMap&& other) noexcept
+    {
+      PersistentMap moved(std::move(other));
+      swap(moved);
+      return *this;
+    }
+
+    PersistentMap snapshot() const noexcept
+    {
+      return PersistentMap(*this);
+    }
+
+    const_iterator begin() const
+    {
+      return cbegin();
+    }
+    const_iterator cbegin() const
+    {
+      const_iterator it(root_);
+      it.fall(root_, true);
+      return it;
+    }
+    const_iterator end() const noexcept
+    {
+      return cend();
+    }
+    const_iterator cend() const noexcept
+    {
+      return const_iterator(root_);
+    }
+    const_rnl_iterator rnl_cbegin() const
+    {
+      const_rnl_iterator it(root_);
+      it.fall(root_, false);
+      return it;
+    }
+    const_rnl_iterator rnl_cend() const noexcept
+    {
+      return const_rnl_iterator(root_);
+    }
+
+    template< class F >
+    F traverse_lnr(F f) const
+    {
+      for (const_iterator i = cbegin(); i != cend(); ++i)
+      {
+        f(*i);
+      }
+      return f;
+    }
+    template< class F >
+    F traverse_rnl(F f) const
+    {
+      for (const_rnl_iterator i = rnl_cbegin(); i != rnl_cend(); ++i)
+      {
+        f(*i);
+      }
+      return f;
+    }
+    template< class F >
+    F traverse_breadth(F f) const
+    {
+      Queue< const Node* > bf_queue;
+      if (root_)
+      {
+        bf_queue.push(root_);
+      }
+      while (!bf_queue.empty())
+      {
+        if (bf_queue.front()->left_)
+        {
+          bf_queue.push(bf_queue.front()->left_);
+        }
+        if (bf_queue.front()->right_)
+        {
+          bf_queue.push(bf_queue.front()->right_);
+        }
+        f(bf_queue.front()->val_);
+        bf_queue.pop();
+      }
+      return f;
+    }
+
+    bool empty() const noexcept
+    {
+      return !size_;
+    }
+    size_t size() const noexcept
+    {
+      return size_;
+    }
+    void clear() noexcept
+    {
+      release(root_);
+      root_ = nullptr;
+      size_ = 0;
+    }
+    void swap(PersistentMap& other) noexcept
+    {
+      std::swap(comparator_, other.comparator_);
+      std::swap(root_, other.root_);
+      std::swap(size_, other.size_);
+    }
+
+    const_iterator find(const Key& key) const
+    {
+      const_iterator it(root_);
+      const Node* cur = root_;
+      while (cur)
+      {
+        it.path_[it.depth_++] = cur;
+        if (comparator_(key, cur->val_.first))
+        {
+          cur = cur->left_;
+        }
+        else if (comparator_(cur->val_.first, key))
+        {
+          cur = cur->right_;
+        }
+        else
+        {
+          return it;
+        }
+      }
+      return cend();
+    }
+    size_t count(const Key& key) const
+    {
+      return findNode(key) != nullptr;
+    }
+    const T& at(const Key& key) const
+    {
+      const Node* node = findNode(key);
+      if (!node)
+      {
+        throw std::out_of_range("No such element");
+      }
+      return node->val_.second;
+    }
+
+    bool insert(const val_t& val)
+    {
+      if (findNode(val.first))
+      {
+        return false;
+      }
+      addNode(root_, val);
+      ++size_;
+      return true;
+    }
+    template< class... Args >
+    bool emplace(Args&&... args)
+    {
+      return insert(val_t(std::forward< Args >(args)...));
+    }
+    bool insert_or_assign(const Key& key, const T& value)
+    {
+      const Node* node = findNode(key);
+      if (node && node->val_.second == value)
+      {
+        return false;
+      }
+      addNode(root_, val_t(key, value));
+      size_ += !node;
+      return !node;
+    }
+    size_t erase(const Key& key)
+    {
+      if (!findNode(key))
+      {
+        return 0;
+      }
+      eraseNode(root_, key);
+      --size_;
+      return 1;
+    }
+  };
+}
+#endif
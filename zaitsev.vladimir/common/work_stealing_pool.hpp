@@ -0,0 +1,175 @@
+#ifndef WORK_STEALING_POOL_HPP
+#define WORK_STEALING_POOL_HPP
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <deque.hpp>
+
+namespace zaitsev
+{
+  // Every worker owns a queue. Tasks submitted from inside a task go to the
+  // front of the submitting worker's queue and are taken from there first,
+  // so a chain of dependent tasks stays on one thread. Tasks from outside
+  // are spread round-robin to the back of the queues. An idle worker steals
+  // from the back of the other queues before going to sleep, taking the
+  // oldest work and leaving the owner the tasks it has just pushed. Stealing
+  // walks the victim's queue, which is cheap next to a task. Tasks must not
+  // throw. The destructor runs every queued task before joining.
+  class WorkStealingPool
+  {
+  public:
+    using task_t = std::function< void() >;
+
+    explicit WorkStealingPool(size_t threads = std::thread::hardware_concurrency()):
+      size_(threads ? threads : 1),
+      workers_(new Worker[size_]),
+      threads_(new std::thread[size_]),
+      queued_(0),
+      next_(0),
+      stop_(false)
+    {
+      size_t started = 0;
+      try
+      {
+        for (; started < size_; ++started)
+        {
+          threads_[started] = std::thread(&WorkStealingPool::work, this, started);
+        }
+      }
+      catch (...)
+      {
+        stop(started);
+        throw;
+      }
+    }
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+    ~WorkStealingPool()
+    {
+      stop(size_);
+    }
+
+    size_t size() const noexcept
+    {
+      return size_;
+    }
+
+    void submit(task_t task)
+    {
+      std::pair< const WorkStealingPool*, size_t >& current = currentWorker();
+      queued_.fetch_add(1, std::memory_order_relaxed);
+      try
+      {
+        if (current.first == this)
+        {
+          std::lock_guard< std::mutex > lock(workers_[current.second].mutex_);
+          workers_[current.second].tasks_.push_front(std::move(task));
+        }
+        else
+        {
+          Worker& worker = workers_[next_.fetch_add(1, std::memory_order_relaxed) % size_];
+          std::lock_guard< std::mutex > lock(worker.mutex_);
+          worker.tasks_.push_back(std::move(task));
+        }
+      }
+      catch (...)
+      {
+        queued_.fetch_sub(1, std::memory_order_relaxed);
+        throw;
+      }
+      {
+        std::lock_guard< std::mutex > lock(sleep_mutex_);
+      }
+      wake_.notify_one();
+    }
+
+  private:
+    struct Worker
+    {
+      std::mutex mutex_;
+      PseudoDeque< task_t > tasks_;
+    };
+
+    size_t size_;
+    std::unique_ptr< Worker[] > workers_;
+    std::unique_ptr< std::thread[] > threads_;
+    std::atomic< size_t > queued_;
+    std::atomic< size_t > next_;
+    std::mutex sleep_mutex_;
+    std::condition_variable wake_;
+    bool stop_;
+
+    static std::pair< const WorkStealingPool*, size_t >& currentWorker()
+    {
+      static thread_local std::pair< const WorkStealingPool*, size_t > current(nullptr, 0);
+      return current;
+    }
+
+    bool take(size_t self, task_t& task)
+    {
+      for (size_t i = 0; i < size_; ++i)
+      {
+        Worker& worker = workers_[(self + i) % size_];
+        std::lock_guard< std::mutex > lock(worker.mutex_);
+        if (!worker.tasks_.empty())
+        {
+          if (i == 0)
+          {
+            task = std::move(worker.tasks_.front());
+            worker.tasks_.pop_front();
+          }
+          else
+          {
+            task = std::move(worker.tasks_.back());
+            worker.tasks_.pop_back();
+          }
+          queued_.fetch_sub(1, std::memory_order_relaxed);
+          return true;
+        }
+      }
+      return false;
+    }
+
+    void work(size_t self)
+    {
+      currentWorker() = std::make_pair(this, self);
+      while (true)
+      {
+        task_t task;
+        if (take(self, task))
+        {
+          task();
+          continue;
+        }
+        std::unique_lock< std::mutex > lock(sleep_mutex_);
+        wake_.wait(lock, [this]()
+        {
+          return stop_ || queued_.load(std::memory_order_relaxed) != 0;
+        });
+        if (stop_ && queued_.load(std::memory_order_relaxed) == 0)
+        {
+          return;
+        }
+      }
+    }
+
+    void stop(size_t started) noexcept
+    {
+      {
+        std::lock_guard< std::mutex > lock(sleep_mutex_);
+        stop_ = true;
+      }
+      wake_.notify_all();
+      for (size_t i = 0; i < started; ++i)
+      {
+        threads_[i].join();
+      }
+    }
+  };
+}
+#endif
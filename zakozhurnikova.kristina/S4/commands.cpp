@@ -16,31 +16,33 @@ void addMap(std::string& mapName, zak::map& toAdd, zak::tree& maps)
   }
 }
 
-void zak::print(const List< std::string >& args, std::string& result, const tree& maps)
+void zak::print(const List< std::string >& args, OutputBuffer& out, const tree& maps)
 {
   if (args.size() != 1)
   {
     throw std::invalid_argument("incorrect command source");
   }
 
-  std::string mapName = args.back();
-  if (!maps.at(mapName).empty())
+  const std::string& mapName = args.back();
+  const map& dictionary = maps.at(mapName);
+  if (dictionary.empty())
   {
-    result = mapName + ' ';
-    for (auto it = maps[mapName].cbegin(); it != maps[mapName].cend(); ++it)
-    {
-      result += std::to_string(it->first) + ' ';
-      result += it->second + ' ';
-    }
-    result.pop_back();
+    out.write("<EMPTY>");
+    out.put('\n');
+    return;
   }
-  else
+  out.write(mapName);
+  for (auto it = dictionary.cbegin(); it != dictionary.cend(); ++it)
   {
-    result = "<EMPTY>";
+    out.put(' ');
+    out.writeInt(it->first);
+    out.put(' ');
+    out.write(it->second);
   }
+  out.put('\n');
 }
 
-void zak::complement(List< std::string >& args, std::string& result, tree& maps)
+void zak::complement(List< std::string >& args, OutputBuffer&, tree& maps)
 {
   if (args.size() != 3)
   {
@@ -61,10 +63,9 @@ void zak::complement(List< std::string >& args, std::string& result, tree& maps)
   }
 
   addMap(args.front(), resultMap, maps);
-  result = std::string();
 }
 
-void zak::intersect(List< std::string >& args, std::string& result, tree& maps)
+void zak::intersect(List< std::string >& args, OutputBuffer&, tree& maps)
 {
   if (args.size() != 3)
   {
@@ -85,10 +86,9 @@ void zak::intersect(List< std::string >& args, std::string& result, tree& maps)
   }
 
   addMap(args.front(), resultMap, maps);
-  result = std::string();
 }
 
-void zak::doUnion(List< std::string >& args, std::string& result, tree& maps)
+void zak::doUnion(List< std::string >& args, OutputBuffer&, tree& maps)
 {
   if (args.size() != 3)
   {
@@ -114,5 +114,4 @@ void zak::doUnion(List< std::string >& args, std::string& result, tree& maps)
   }
 
   addMap(args.front(), resultMap, maps);
-  result = std::string();
 }
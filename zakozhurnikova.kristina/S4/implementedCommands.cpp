@@ -8,7 +8,7 @@ using map = zak::BinarySearchTree< int, std::string >;
 zak::ImplementedCommands::ImplementedCommands(BinarySearchTree< std::string, map >& maps):
   maps_(maps)
 {}
-void zak::ImplementedCommands::executeCommand(std::istream& input, std::string& result)
+void zak::ImplementedCommands::executeCommand(std::istream& input, OutputBuffer& out)
 {
   ScopeGuard guard(input);
   input >> std::noskipws;
@@ -28,7 +28,6 @@ void zak::ImplementedCommands::executeCommand(std::istream& input, std::string&
 
   if (args.empty())
   {
-    result = std::string();
     return;
   }
 
@@ -36,13 +35,13 @@ void zak::ImplementedCommands::executeCommand(std::istream& input, std::string&
   args.pop_front();
   try
   {
-    (*commands_.at(cmdName))(args, result, maps_);
+    (*commands_.at(cmdName))(args, out, maps_);
   }
   catch (const std::out_of_range& e)
   {
     try
     {
-      (*printCmd_.at(cmdName))(args, result, maps_);
+      (*printCmd_.at(cmdName))(args, out, maps_);
     }
     catch (const std::out_of_range&)
     {
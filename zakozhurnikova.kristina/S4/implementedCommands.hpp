@@ -3,16 +3,17 @@
 #include <string>
 #include <binarySearchTree.hpp>
 #include <list.hpp>
+#include "outputBuffer.hpp"
 
 namespace zakozhurnikova
 {
   using map = BinarySearchTree< int, std::string >;
   struct ImplementedCommands
   {
-    using Command = void (*)(List< std::string >&, std::string&, BinarySearchTree< std::string, map >&);
-    using PrintCmd = void(*)(const List< std::string >&, std::string&, const BinarySearchTree< std::string, map >&);
+    using Command = void (*)(List< std::string >&, OutputBuffer&, BinarySearchTree< std::string, map >&);
+    using PrintCmd = void(*)(const List< std::string >&, OutputBuffer&, const BinarySearchTree< std::string, map >&);
     explicit ImplementedCommands(BinarySearchTree< std::string, map >& maps);
-    void executeCommand(std::istream& in, std::string& result);
+    void executeCommand(std::istream& in, OutputBuffer& out);
     void addCommand(const std::string& nameCommand, Command command);
     void addCommand(const std::string& nameCommand, PrintCmd command);
 
@@ -6,6 +6,7 @@
 #include "implementedCommands.hpp"
 #include "inputMaps.hpp"
 #include "commands.hpp"
+#include "outputBuffer.hpp"
 
 int main(int argc, char *argv[])
 {
@@ -29,23 +30,20 @@ int main(int argc, char *argv[])
   implementer.addCommand("union", &doUnion);
   implementer.addCommand("complement", &complement);
   implementer.addCommand("intersect", &intersect);
-  std::string cmdOutput;
+  OutputBuffer output(std::cout);
   while (!std::cin.eof())
   {
     try
     {
-      implementer.executeCommand(std::cin, cmdOutput);
-      if (!cmdOutput.empty())
-      {
-        std::cout << cmdOutput << '\n';
-      }
+      implementer.executeCommand(std::cin, output);
     }
     catch (const std::invalid_argument &e)
     {
-      std::cout << "<INVALID COMMAND>\n";
+      output.write("<INVALID COMMAND>\n");
     }
     catch (const std::exception &e)
     {
+      output.flush();
       std::cerr << e.what();
       return 1;
     }
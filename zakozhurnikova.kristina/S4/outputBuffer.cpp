@@ -0,0 +1,70 @@
+#include "outputBuffer.hpp"
+#include <ostream>
+
+zakozhurnikova::OutputBuffer::OutputBuffer(std::ostream& out, size_t blockSize):
+  out_(out),
+  buffer_(),
+  blockSize_(blockSize)
+{
+  buffer_.reserve(blockSize_ * 2);
+}
+
+zakozhurnikova::OutputBuffer::~OutputBuffer()
+{
+  try
+  {
+    flush();
+  }
+  catch (...)
+  {}
+}
+
+void zakozhurnikova::OutputBuffer::put(char c)
+{
+  buffer_.push_back(c);
+  flushIfFull();
+}
+
+void zakozhurnikova::OutputBuffer::write(const std::string& str)
+{
+  buffer_.append(str);
+  flushIfFull();
+}
+
+void zakozhurnikova::OutputBuffer::writeInt(long long value)
+{
+  char digits[24];
+  char* end = digits + sizeof(digits);
+  char* begin = end;
+  unsigned long long magnitude = value < 0 ? 0ULL - static_cast< unsigned long long >(value) : value;
+  do
+  {
+    *--begin = static_cast< char >('0' + magnitude % 10);
+    magnitude /= 10;
+  }
+  while (magnitude != 0);
+  if (value < 0)
+  {
+    *--begin = '-';
+  }
+  buffer_.append(begin, end);
+  flushIfFull();
+}
+
+void zakozhurnikova::OutputBuffer::flush()
+{
+  if (!buffer_.empty())
+  {
+    out_.write(buffer_.data(), buffer_.size());
+    buffer_.clear();
+  }
+  out_.flush();
+}
+
+void zakozhurnikova::OutputBuffer::flushIfFull()
+{
+  if (buffer_.size() >= blockSize_)
+  {
+    flush();
+  }
+}
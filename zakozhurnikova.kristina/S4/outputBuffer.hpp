@@ -0,0 +1,31 @@
+#ifndef OUTPUT_BUFFER_HPP
+#define OUTPUT_BUFFER_HPP
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+
+namespace zakozhurnikova
+{
+  class OutputBuffer
+  {
+  public:
+    explicit OutputBuffer(std::ostream& out, size_t blockSize = 1 << 16);
+    OutputBuffer(const OutputBuffer&) = delete;
+    OutputBuffer& operator=(const OutputBuffer&) = delete;
+    ~OutputBuffer();
+
+    void put(char c);
+    void write(const std::string& str);
+    void writeInt(long long value);
+    void flush();
+
+  private:
+    std::ostream& out_;
+    std::string buffer_;
+    size_t blockSize_;
+
+    void flushIfFull();
+  };
+}
+
+#endif
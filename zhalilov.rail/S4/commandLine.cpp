@@ -0,0 +1,88 @@
+#include "commandLine.hpp"
+
+#include <cstring>
+#include <istream>
+#include <stdexcept>
+
+namespace
+{
+  bool isDelimiter(char c)
+  {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+  }
+}
+
+bool zhalilov::operator==(const StringSlice &slice, const std::string &str)
+{
+  return slice.size == str.size() && std::memcmp(slice.data, str.data(), slice.size) == 0;
+}
+
+zhalilov::CommandLine::CommandLine():
+  count_(0)
+{}
+
+bool zhalilov::CommandLine::read(std::istream &input)
+{
+  count_ = 0;
+  if (!std::getline(input, line_))
+  {
+    return false;
+  }
+
+  const char *it = line_.data();
+  const char *end = it + line_.size();
+  while (it != end)
+  {
+    while (it != end && isDelimiter(*it))
+    {
+      it++;
+    }
+    if (it == end)
+    {
+      break;
+    }
+    const char *begin = it;
+    while (it != end && !isDelimiter(*it))
+    {
+      it++;
+    }
+    if (count_ == maxTokens)
+    {
+      count_ = 0;
+      throw std::invalid_argument("too many tokens in command line");
+    }
+    tokens_[count_++] = StringSlice{ begin, static_cast< size_t >(it - begin) };
+  }
+  return true;
+}
+
+bool zhalilov::CommandLine::empty() const noexcept
+{
+  return count_ == 0;
+}
+
+zhalilov::StringSlice zhalilov::CommandLine::name() const noexcept
+{
+  return count_ ? tokens_[0] : StringSlice{ line_.data(), 0 };
+}
+
+size_t zhalilov::CommandLine::argCount() const noexcept
+{
+  return count_ ? count_ - 1 : 0;
+}
+
+zhalilov::StringSlice zhalilov::CommandLine::arg(size_t i) const
+{
+  if (i >= argCount())
+  {
+    throw std::out_of_range("command argument index out of range");
+  }
+  return tokens_[i + 1];
+}
+
+const std::string &zhalilov::CommandLine::argString(size_t i) const
+{
+  StringSlice slice = arg(i);
+  keys_[i].assign(slice.data, slice.size);
+  return keys_[i];
+}
@@ -0,0 +1,41 @@
+#ifndef COMMANDLINE_HPP
+#define COMMANDLINE_HPP
+
+#include <cstddef>
+#include <string>
+#include <iosfwd>
+
+namespace zhalilov
+{
+  struct StringSlice
+  {
+    const char *data;
+    size_t size;
+  };
+
+  bool operator==(const StringSlice &, const std::string &);
+
+  class CommandLine
+  {
+  public:
+    CommandLine();
+
+    bool read(std::istream &input);
+
+    bool empty() const noexcept;
+    StringSlice name() const noexcept;
+    size_t argCount() const noexcept;
+    StringSlice arg(size_t) const;
+    const std::string &argString(size_t) const;
+
+  private:
+    static constexpr size_t maxTokens = 8;
+
+    std::string line_;
+    StringSlice tokens_[maxTokens];
+    size_t count_;
+    mutable std::string keys_[maxTokens];
+  };
+}
+
+#endif
@@ -1,27 +1,31 @@
 #include "commands.hpp"
 
-void zhalilov::commands::printCmd(mapOfMaps &maps, List < std::string > &cmdSource, std::string &result)
+#include <stdexcept>
+#include <utility>
+
+void zhalilov::commands::printCmd(mapOfMaps &maps, const CommandLine &cmdLine, std::string &result)
 {
-  if (cmdSource.capacity() != 1)
+  if (cmdLine.argCount() != 1)
   {
     throw std::invalid_argument("incorrect command source");
   }
 
-  std::string mapName = cmdSource.back();
-  if (!maps.at(mapName).empty())
+  StringSlice mapName = cmdLine.arg(0);
+  const intStringMap &map = maps.at(cmdLine.argString(0));
+  result.clear();
+  if (!map.empty())
   {
-    auto it = maps[mapName].cbegin();
-    auto end = maps[mapName].cend();
-    end--;
-    result = mapName + ' ';
+    result.append(mapName.data, mapName.size);
+    auto it = map.cbegin();
+    auto end = map.cend();
     while (it != end)
     {
-      result += std::to_string(it->first) + ' ';
-      result += it->second + ' ';
+      result += ' ';
+      result += std::to_string(it->first);
+      result += ' ';
+      result += it->second;
       it++;
     }
-    result += std::to_string(it->first) + ' ';
-    result += it->second;
   }
   else
   {
@@ -29,81 +33,74 @@ void zhalilov::commands::printCmd(mapOfMaps &maps, List < std::string > &cmdSour
   }
 }
 
-void zhalilov::commands::complementCmd(mapOfMaps &maps, List < std::string > &cmdSource, std::string &result)
+void zhalilov::commands::complementCmd(mapOfMaps &maps, const CommandLine &cmdLine, std::string &result)
 {
-  if (cmdSource.capacity() != 3)
+  if (cmdLine.argCount() != 3)
   {
     throw std::invalid_argument("incorrect command source");
   }
 
-  intStringMap &secondMap = maps.at(cmdSource.back());
-  cmdSource.pop_back();
-  intStringMap &firstMap = maps.at(cmdSource.back());
+  const intStringMap &secondMap = maps.at(cmdLine.argString(2));
+  const intStringMap &firstMap = maps.at(cmdLine.argString(1));
   intStringMap resultMap;
 
   auto firstIt = firstMap.cbegin();
   auto firstEnd = firstMap.cend();
   while (firstIt != firstEnd)
   {
-    if (secondMap.find(firstIt->first) == secondMap.end())
+    if (secondMap.find(firstIt->first) == secondMap.cend())
     {
-      int currKey = firstIt->first;
-      std::string currValue = firstIt->second;
-      resultMap.insert(std::pair < int, std::string >(currKey, currValue));
+      resultMap.insert(*firstIt);
     }
     firstIt++;
   }
 
-  maps[cmdSource.front()] = resultMap;
-  result = std::string();
+  maps[cmdLine.argString(0)] = std::move(resultMap);
+  result.clear();
 }
 
-void zhalilov::commands::intersectCmd(mapOfMaps &maps, List < std::string > &cmdSource, std::string &result)
+void zhalilov::commands::intersectCmd(mapOfMaps &maps, const CommandLine &cmdLine, std::string &result)
 {
-  if (cmdSource.capacity() != 3)
+  if (cmdLine.argCount() != 3)
   {
     throw std::invalid_argument("incorrect command source");
   }
 
-  intStringMap &secondMap = maps.at(cmdSource.back());
-  cmdSource.pop_back();
-  intStringMap &firstMap = maps.at(cmdSource.back());
+  const intStringMap &secondMap = maps.at(cmdLine.argString(2));
+  const intStringMap &firstMap = maps.at(cmdLine.argString(1));
   intStringMap resultMap;
 
   auto firstIt = firstMap.cbegin();
   auto firstEnd = firstMap.cend();
   while (firstIt != firstEnd)
   {
-    if (secondMap.find(firstIt->first) != secondMap.end())
+    if (secondMap.find(firstIt->first) != secondMap.cend())
     {
-      int currKey = firstIt->first;
-      std::string currValue = firstIt->second;
-      resultMap.insert(std::pair < int, std::string >(currKey, currValue));
+      resultMap.insert(*firstIt);
     }
     firstIt++;
   }
 
-  maps[cmdSource.front()] = resultMap;
-  result = std::string();
+  maps[cmdLine.argString(0)] = std::move(resultMap);
+  result.clear();
 }
 
-void zhalilov::commands::unionCmd(mapOfMaps &maps, List < std::string > &cmdSource, std::string &result)
+void zhalilov::commands::unionCmd(mapOfMaps &maps, const CommandLine &cmdLine, std::string &result)
 {
-  if (cmdSource.capacity() != 3)
+  if (cmdLine.argCount() != 3)
   {
     throw std::invalid_argument("incorrect command source");
   }
 
-  intStringMap &secondMap = maps.at(cmdSource.back());
-  cmdSource.pop_back();
-  intStringMap &firstMap = maps.at(cmdSource.back());
+  const intStringMap &secondMap = maps.at(cmdLine.argString(2));
+  const intStringMap &firstMap = maps.at(cmdLine.argString(1));
   intStringMap resultMap;
 
   auto firstIt = firstMap.cbegin();
   auto firstEnd = firstMap.cend();
   while (firstIt != firstEnd)
   {
-    resultMap.insert(std::pair < int, std::string >(firstIt->first, firstIt->second));
+    resultMap.insert(*firstIt);
     firstIt++;
   }
 
@@ -111,10 +108,10 @@ void zhalilov::commands::unionCmd(mapOfMaps &maps, List < std::string > &cmdSour
   auto secondEnd = secondMap.cend();
   while (secondIt != secondEnd)
   {
-    resultMap.insert(std::pair < int, std::string >(secondIt->first, secondIt->second));
+    resultMap.insert(*secondIt);
     secondIt++;
   }
 
-  maps[cmdSource.front()] = resultMap;
-  result = std::string();
+  maps[cmdLine.argString(0)] = std::move(resultMap);
+  result.clear();
 }
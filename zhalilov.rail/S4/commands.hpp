@@ -4,9 +4,10 @@
 #include <string>
 #include <iosfwd>
 
-#include <list/list.hpp>
 #include <tree/twoThreeTree.hpp>
 
+#include "commandLine.hpp"
+
 namespace zhalilov
 {
   using intStringMap = TwoThree < int, std::string >;
@@ -14,10 +15,10 @@ namespace zhalilov
 
   namespace commands
   {
-    void printCmd(mapOfMaps &, List < std::string > &cmdSource, std::string &result);
-    void complementCmd(mapOfMaps &, List < std::string > &cmdSource, std::string &result);
-    void intersectCmd(mapOfMaps &, List < std::string > &cmdSource, std::string &result);
-    void unionCmd(mapOfMaps &, List < std::string > &cmdSource, std::string &result);
+    void printCmd(mapOfMaps &, const CommandLine &cmdLine, std::string &result);
+    void complementCmd(mapOfMaps &, const CommandLine &cmdLine, std::string &result);
+    void intersectCmd(mapOfMaps &, const CommandLine &cmdLine, std::string &result);
+    void unionCmd(mapOfMaps &, const CommandLine &cmdLine, std::string &result);
   }
 }
 
@@ -1,56 +1,105 @@
 #include "mapMaster.hpp"
 
-#include <iostream>
+#include <utility>
+#include <limits>
+#include <stdexcept>
 
 zhalilov::MapMaster::MapMaster(TwoThree < std::string, intStringMap > &maps):
-  maps_(maps)
+  maps_(maps),
+  count_(0),
+  slots_(),
+  seed_(0)
 {}
 
 void zhalilov::MapMaster::doCommandLine(std::istream &input, std::string &result)
 {
-  std::ios_base::fmtflags ff(input.flags());
-  input >> std::noskipws;
-  List < std::string > cmdSource;
-  std::string tmp;
-  char delim = 0;
+  result.clear();
+  if (!line_.read(input) || line_.empty())
+  {
+    return;
+  }
+
+  size_t id = findCommand(line_.name());
+  if (id == count_)
+  {
+    throw std::invalid_argument("invalid command name");
+  }
   try
   {
-    while (input && delim != '\n')
-    {
-      input >> tmp;
-      if (input)
-      {
-        cmdSource.push_back(tmp);
-      }
-      input >> delim;
-    }
+    funcs_[id](maps_, line_, result);
   }
-  catch (...)
+  catch (const std::out_of_range &e)
   {
-    input.flags(ff);
-    throw;
+    throw std::invalid_argument("invalid command name");
   }
-  input.flags(ff);
+}
 
-  if (cmdSource.empty())
+void zhalilov::MapMaster::addCommand(std::string name, commandFunc func)
+{
+  StringSlice slice{ name.data(), name.size() };
+  size_t id = findCommand(slice);
+  if (id != count_)
   {
-    result = std::string();
+    funcs_[id] = func;
     return;
   }
+  if (count_ == maxCommands)
+  {
+    throw std::length_error("too many commands");
+  }
 
-  try
+  names_[count_] = std::move(name);
+  funcs_[count_] = func;
+  count_++;
+  for (uint32_t seed = 0; seed != std::numeric_limits< uint32_t >::max(); seed++)
+  {
+    if (buildTable(seed))
+    {
+      seed_ = seed;
+      return;
+    }
+  }
+  count_--;
+  buildTable(seed_);
+  throw std::length_error("no perfect hash for commands");
+}
+
+size_t zhalilov::MapMaster::hash(StringSlice slice, uint32_t seed) noexcept
+{
+  uint32_t h = 2166136261u ^ seed;
+  for (size_t i = 0; i < slice.size; i++)
   {
-    std::string cmdName = cmdSource.front();
-    cmdSource.pop_front();
-    commands_.at(cmdName)(maps_, cmdSource, result);
+    h ^= static_cast< unsigned char >(slice.data[i]);
+    h *= 16777619u;
   }
-  catch (const std::out_of_range &e)
+  h ^= h >> 15;
+  return h & (tableSize - 1);
+}
+
+bool zhalilov::MapMaster::buildTable(uint32_t seed) noexcept
+{
+  for (size_t i = 0; i < tableSize; i++)
   {
-    throw std::invalid_argument("invalid command name");
+    slots_[i] = 0;
   }
+  for (size_t i = 0; i < count_; i++)
+  {
+    size_t slot = hash(StringSlice{ names_[i].data(), names_[i].size() }, seed);
+    if (slots_[slot])
+    {
+      return false;
+    }
+    slots_[slot] = static_cast< unsigned char >(i + 1);
+  }
+  return true;
 }
 
-void zhalilov::MapMaster::addCommand(std::string name, commandFunc func)
+size_t zhalilov::MapMaster::findCommand(StringSlice name) const noexcept
 {
-  commands_[name] = func;
+  size_t slot = slots_[hash(name, seed_)];
+  if (slot && name == names_[slot - 1])
+  {
+    return slot - 1;
+  }
+  return count_;
 }
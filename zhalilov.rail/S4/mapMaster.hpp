@@ -1,12 +1,15 @@
 #ifndef MAPMASTER_HPP
 #define MAPMASTER_HPP
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <iosfwd>
 
-#include <list/list.hpp>
 #include <tree/twoThreeTree.hpp>
 
+#include "commandLine.hpp"
+
 namespace zhalilov
 {
   class MapMaster
@@ -14,15 +17,27 @@ namespace zhalilov
   public:
     using intStringMap = TwoThree < int, std::string >;
     using mapOfMaps = TwoThree < std::string, intStringMap >;
-    using commandFunc = void (*)(mapOfMaps &, List < std::string > &, std::string &);
+    using commandFunc = void (*)(mapOfMaps &, const CommandLine &, std::string &);
 
     explicit MapMaster(TwoThree < std::string, intStringMap > &maps);
     void doCommandLine(std::istream &input, std::string &result);
     void addCommand(std::string name, commandFunc func);
 
   private:
+    static constexpr size_t maxCommands = 16;
+    static constexpr size_t tableSize = 64;
+
     mapOfMaps &maps_;
-    TwoThree < std::string, commandFunc > commands_;
+    CommandLine line_;
+    std::string names_[maxCommands];
+    commandFunc funcs_[maxCommands];
+    size_t count_;
+    unsigned char slots_[tableSize];
+    uint32_t seed_;
+
+    static size_t hash(StringSlice, uint32_t seed) noexcept;
+    bool buildTable(uint32_t seed) noexcept;
+    size_t findCommand(StringSlice) const noexcept;
   };
 }
 
@@ -0,0 +1,111 @@
+#define BOOST_TEST_MODULE S4
+#include <boost/test/included/unit_test.hpp>
+
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <vector>
+#include <tree/bTree.hpp>
+
+namespace
+{
+  struct Collect
+  {
+    std::vector< int > keys;
+    void operator()(const std::pair< int, int > &pair)
+    {
+      keys.push_back(pair.first);
+    }
+  };
+
+  template < class Tree >
+  void checkContents(const Tree &tree, const std::map< int, int > &model)
+  {
+    BOOST_REQUIRE_EQUAL(tree.size(), model.size());
+    auto expected = model.cbegin();
+    for (auto it = tree.cbegin(); it != tree.cend(); ++it, ++expected)
+    {
+      BOOST_REQUIRE(expected != model.cend());
+      BOOST_REQUIRE_EQUAL(it->first, expected->first);
+      BOOST_REQUIRE_EQUAL(it->second, expected->second);
+    }
+    BOOST_REQUIRE(expected == model.cend());
+    auto reversed = model.crbegin();
+    for (auto it = tree.cend(); it != tree.cbegin(); ++reversed)
+    {
+      --it;
+      BOOST_REQUIRE_EQUAL(it->first, reversed->first);
+    }
+  }
+
+  template < class Tree >
+  void runMixed(unsigned seed)
+  {
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution< int > keys(0, 500);
+    std::uniform_int_distribution< int > ops(0, 2);
+    Tree tree;
+    std::map< int, int > model;
+    for (int step = 0; step < 5000; ++step)
+    {
+      int key = keys(gen);
+      switch (ops(gen))
+      {
+      case 0:
+        BOOST_REQUIRE_EQUAL(tree.insert(std::make_pair(key, step)).second, model.insert(std::make_pair(key, step)).second);
+        break;
+      case 1:
+        BOOST_REQUIRE_EQUAL(tree.erase(key), model.erase(key));
+        break;
+      default:
+        BOOST_REQUIRE_EQUAL(tree.count(key), model.count(key));
+      }
+      if (step % 250 == 0)
+      {
+        checkContents(tree, model);
+      }
+    }
+    checkContents(tree, model);
+    Tree copy(tree);
+    checkContents(copy, model);
+    if (!model.empty())
+    {
+      std::vector< int > expected;
+      for (auto &pair: model)
+      {
+        expected.push_back(pair.first);
+      }
+      BOOST_CHECK(tree.traverse_lnr(Collect()).keys == expected);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(empty_tree)
+{
+  zhalilov::BTree< int, int > tree;
+  BOOST_CHECK(tree.begin() == tree.end());
+  auto it = tree.end();
+  --it;
+  BOOST_CHECK(it == tree.end());
+  const zhalilov::BTree< int, int > &ctree = tree;
+  auto cit = ctree.cend();
+  --cit;
+  BOOST_CHECK(cit == ctree.cend());
+  BOOST_CHECK_THROW(ctree.at(1), std::out_of_range);
+  BOOST_CHECK_THROW(ctree.traverse_lnr(Collect()), std::logic_error);
+}
+
+BOOST_AUTO_TEST_CASE(order_three_matches_model)
+{
+  runMixed< zhalilov::BTree< int, int, std::less< int >, 3 > >(3);
+}
+
+BOOST_AUTO_TEST_CASE(order_four_matches_model)
+{
+  runMixed< zhalilov::BTree< int, int, std::less< int >, 4 > >(4);
+}
+
+BOOST_AUTO_TEST_CASE(default_order_matches_model)
+{
+  runMixed< zhalilov::BTree< int, int > >(64);
+}
@@ -0,0 +1,809 @@
+#ifndef BTREE_HPP
+#define BTREE_HPP
+
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+
+#include <queue.hpp>
+
+#include "bTreeIterator.hpp"
+#include "bTreeNode.hpp"
+#include "const_bTreeIterator.hpp"
+
+namespace zhalilov
+{
+  // Same interface as TwoThree, but every node keeps up to Order - 1 pairs
+  // in one array, so a lookup scans a few cache lines per level instead of
+  // following a pointer per key. Order = 3 gives a 2-3 tree.
+  template < class Key, class T, class Compare = std::less< Key >,
+    size_t Order = detail::defaultBTreeOrder< Key, T >() >
+  class BTree
+  {
+    static_assert(Order >= 3, "BTree: order must be at least 3");
+
+  public:
+    using MapPair = std::pair< Key, T >;
+    using iterator = BTreeIterator< MapPair, Order >;
+    using const_iterator = ConstBTreeIterator< MapPair, Order >;
+
+    BTree();
+    BTree(const BTree &);
+    BTree(BTree &&) noexcept;
+    ~BTree();
+
+    BTree &operator=(const BTree &);
+    BTree &operator=(BTree &&) noexcept;
+
+    T &at(const Key &);
+    const T &at(const Key &) const;
+    T &operator[](const Key &);
+    T &operator[](Key &&);
+
+    iterator begin();
+    const_iterator begin() const;
+    const_iterator cbegin() const noexcept;
+    iterator end();
+    const_iterator end() const;
+    const_iterator cend() const noexcept;
+
+    bool empty() const noexcept;
+    size_t size() const noexcept;
+
+    std::pair< iterator, bool > insert(const MapPair &);
+    std::pair< iterator, bool > insert(MapPair &&);
+    iterator erase(iterator);
+    iterator erase(const_iterator);
+    size_t erase(const Key &);
+    void clear() noexcept;
+    void swap(BTree &) noexcept;
+
+    iterator find(const Key &);
+    const_iterator find(const Key &) const;
+
+    template < class F >
+    F traverse_lnr(F f) const;
+    template < class F >
+    F traverse_lnr(F f);
+    template < class F >
+    F traverse_rnl(F f) const;
+    template < class F >
+    F traverse_rnl(F f);
+    template < class F >
+    F traverse_breadth(F f) const;
+    template < class F >
+    F traverse_breadth(F f);
+
+    size_t count(const Key &) const;
+    std::pair< iterator, iterator > equal_range(const Key &);
+    std::pair< const_iterator, const_iterator > equal_range(const Key &) const;
+
+  private:
+    using Node = detail::BTreeNode< MapPair, Order >;
+    using InnerNode = detail::BTreeInnerNode< MapPair, Order >;
+    static constexpr size_t maxCount = Order - 1;
+    static constexpr size_t minCount = (Order - 1) / 2;
+
+    Compare compare_;
+    InnerNode head_;
+    size_t size_;
+
+    Node *head() const noexcept;
+    Node *root() const noexcept;
+    void setRoot(Node *) noexcept;
+
+    size_t lowerIndex(const Node *, const Key &) const;
+    std::pair< iterator, bool > doFind(const Key &) const;
+    template < class P >
+    std::pair< iterator, bool > doInsert(P &&);
+    Node *split(Node *, iterator &);
+    void rebalance(Node *);
+    void rotateLeft(InnerNode *parent, size_t sep);
+    void rotateRight(InnerNode *parent, size_t sep);
+    void merge(InnerNode *parent, size_t sep);
+
+    template < class F >
+    static void doTraverseLnr(const Node *, F &);
+    template < class F >
+    static void doTraverseRnl(const Node *, F &);
+
+    static Node *createNode(bool isLeaf);
+    static void deleteNode(Node *) noexcept;
+    static void deleteSubtree(Node *) noexcept;
+    static Node *copySubtree(const Node *, Node *parent);
+    static void moveChildren(InnerNode *from, size_t first, size_t last, InnerNode *to, size_t dest);
+  };
+
+  template < class Key, class T, class Compare, size_t Order >
+  BTree< Key, T, Compare, Order >::BTree():
+    compare_(Compare{}),
+    head_(),
+    size_(0)
+  {}
+
+  template < class Key, class T, class Compare, size_t Order >
+  BTree< Key, T, Compare, Order >::BTree(const BTree &other):
+    compare_(other.compare_),
+    head_(),
+    size_(other.size_)
+  {
+    if (other.root())
+    {
+      setRoot(copySubtree(other.root(), head()));
+    }
+  }
+
+  template < class Key, class T, class Compare, size_t Order >
+  BTree< Key, T, Compare, Order >::BTree(BTree &&other) noexcept:
+    compare_(std::move(other.compare_)),
+    head_(),
+    size_(other.size_)
+  {
+    setRoot(other.root());
+    other.setRoot(nullptr);
+    other.size_ = 0;
+  }
+
+  template < class Key, class T, class Compare, size_t Order >
+  BTree< Key, T, Compare, Order >::~BTree()
+  {
+    clear();
+  }
+
+  template < class Key, class T, class Compare, size_t Order >
+  BTree< Key, T, Compare, Order > &BTree< Key, T, Compare, Order >::operator=(const BTree &other)
+  {
+    if (this != &other)
+    {
+      BTree temp(other);
+      swap(temp);
+    }
+    return *this;
+  }
+
+  template < class Key, class T, class Compare, size_t Order >
+  BTree< Key, T, Compare, Order > &BTree< Key, T, Compare, Order >::operator=(BTree &&other) noexcept
+  {
+    if (this != &other)
+    {
+      BTree temp(std::move(other));
+      swap(temp);
+    }
+    return *this;
+  }
+
+  template < class Key, class T, class Compare, size_t Order >
+  T &BTree< Key, T, Compare, Order >::at(const Key &key)
+  {
+    auto resultPair = doFind(key);
+    if (!resultPair.second)
+    {
+      throw std::out_of_range("BTree: accessing element doesn't exist");
+    }
+    return resultPair.first->second;
+  }
+
+  template < class Key, class T, class Compare, size_t Order >
+  const T &BTree< Key, T, Compare, Order >::at(const Key &key) const
+  {
+    auto resultPair = doFind(key);
+    if (!resultPair.second)
+    {
+      throw std::out_of_range("BTree: accessing element doesn't exist");
+    }
+    return resultPair.first->second;
+  }
+
+  template < class Key, class T, class Compare, size_t Order >
+  T &BTree< Key, T, Compare, Order >::operator[](const Key &key)
+  {
+    auto resultPair = doFind(key);
+    if (resultPair.second)
+    {
+      return resultPair.first->second;
+    }
+    return doInsert(std::make_pair(key, T())).first->second;
+  }
+
+  template < class Key, class T, class Compare, size_t Order >
+  T &BTree< Key, T, Compare, Order >::operator[](Key &&key)
+  {
+    auto resultPair = doFind(key);
+    if (resultPair.second)
+    {
+      return resultPair.first->second;
+    }
+    return doInsert(std::make_pair(std::move(key), T())).first->second;
+  }
+
+  template < class Key, class T, class Compare, size_t Order >
+  typename BTree< Key, T, Compare, Order >::iterator BTree< Key, T, Compare, Order >::begin()
+  {
+    return iterator(detail::findDeepestLeft(head()), 0);
+  }
+
+  template < class Key, class T, class Compare, size_t Order >
+  typename BTree< Key, T, Compare, Order >::const_iterator BTree< Key, T, Compare, Order >::begin() const
+  {
+    return cbegin();
+  }
+
+  template < class Key, class T, class Compare, size_t Order >
+  typename BTree< Key, T, Compare, Order >::const_iterator BTree< Key, T, Compare, Order >::cbegin() const noexcept
+  {
+    return const_iterator(detail::findDeepestLeft(head()), 0);
+  }
+
+  template < class Key, class T, class Compare, size_t Order >
+  typename BTree< Key, T, Compare, Order >::iterator BTree< Key, T, Compare, Order >::end()
+  {
+    return iterator(head(), 0);
+  }
+
+  template < class Key, class T, class Compare, size_t Order >
+  typename BTree< Key, T, Compare, Order >::const_iterator BTree< Key, T, Compare, Order >::end() const
+  {
+    return cend();
+  }
+
+  template < class Key, class T, class Compare, size_t Order >
+  typename BTree< Key, T, Compare, Order >::const_iterator BTree< Key, T, Compare, Order >::cend() const noexcept
+  {
+    return const_iterator(head(), 0);
+  }
+
+  template < class Key, class T, class Compare, size_t Order >
+  bool BTree< Key, T, Compare, Order >::empty() const noexcept
+  {
+    return size_ == 0;
+  }
+
+  template < class Key, class T, class Compare, size_t Order >
+  size_t BTree< Key, T, Compare, Order >::size() const noexcept
+  {
+    return size_;
+  }
+
+  template < class Key, class T, class Compare, size_t Order >
+  std::pair< typename BTree< Key, T, Compare, Order >::iterator, bool >
+  BTree< Key, T, Compare, Order >::insert(const MapPair &newPair)
+  {
+    return doInsert(newPair);
+  }
+
+  template < class Key, class T, class Compare, size_t Order >
+  std::pair< typename BTree< Key, T, Compare, Order >::iterator, bool >
+  BTree< Key, T, Compare, Order >::insert(MapPair &&newPair)
+  {
+    return doInsert(std::move(newPair));
+  }
+
+  template < class Key, class T, class Compare, size_t Order >
+  typename BTree< Key, T, Compare, Order >::iterator BTree< Key, T, Compare, Order >::erase(iterator it)
+  {
+    Key key = it->first;
+    Node *currNode = it.node_;
+    size_t index = it.index_;
+    if (!currNode->isLeaf)
+    {
+      Node *maxLeft = detail::findDeepestRight(detail::toInner(currNode)->children[index]);
+      currNode->pairs[index] = std::move(maxLeft->pairs[maxLeft->count - 1]);
+      currNode = maxLeft;
+      index = maxLeft->count - 1;
+    }
+    std::move(currNode->pairs + index + 1, currNode->pairs + currNode->count, currNode->pairs + index);
+    currNode->count--;
+    size_--;
+    rebalance(currNode);
+    return doFind(key).first;
+  }
+
+  template < class Key, class T, class Compare, size_t Order >
+  typename BTree< Key, T, Compare, Order >::iterator BTree< Key, T, Compare, Order >::erase(const_iterator it)
+  {
+    return erase(iterator(it.node_, it.index_));
+  }
+
+  template < class Key, class T, class Compare, size_t Order >
+  size_t BTree< Key, T, Compare, Order >::erase(const Key &key)
+  {
+    auto resultPair = doFind(key);
+    if (!resultPair.second)
+    {
+      return 0;
+    }
+    erase(resultPair.first);
+    return 1;
+  }
+
+  template < class Key, class T, class Compare, size_t Order >
+  void BTree< Key, T, Compare, Order >::clear() noexcept
+  {
+    deleteSubtree(root());
+    setRoot(nullptr);
+    size_ = 0;
+  }
+
+  template < class Key, class T, class Compare, size_t Order >
+  void BTree< Key, T, Compare, Order >::swap(BTree &other) noexcept
+  {
+    std::swap(compare_, other.compare_);
+    std::swap(size_, other.size_);
+    Node *otherRoot = other.root();
+    other.setRoot(root());
+    setRoot(otherRoot);
+  }
+
+  template < class Key, class T, class Compare, size_t Order >
+  typename BTree< Key, T, Compare, Order >::iterator BTree< Key, T, Compare, Order >::find(const Key &key)
+  {
+    auto resultPair = doFind(key);
+    return resultPair.second ? resultPair.first : end();
+  }
+
+  template < class Key, class T, class Compare, size_t Order >
+  typename BTree< Key, T, Compare, Order >::const_iterator BTree< Key, T, Compare, Order >::find(const Key &key) const
+  {
+    auto resultPair = doFind(key);
+    return resultPair.second ? const_iterator(resultPair.first) : cend();
+  }
+
+  template < class Key, class T, class Compare, size_t Order >
+  template < class F >
+  F BTree< Key, T, Compare, Order >::traverse_lnr(F f) const
+  {
+    if (empty())
+    {
+      throw std::logic_error("travers_lnr: empty tree");
+    }
+    doTraverseLnr(root(), f);
+    return f;
+  }
+
+  template < class Key, class T, class Compare, size_t Order >
+  template < class F >
+  F BTree< Key, T, Compare, Order >::traverse_lnr(F f)
+  {
+    return static_cast< const BTree & >(*this).traverse_lnr(f);
+  }
+
+  template < class Key, class T, class Compare, size_t Order >
+  template < class F >
+  F BTree< Key, T, Compare, Order >::traverse_rnl(F f) const
+  {
+    if (empty())
+    {
+      throw std::logic_error("travers_rnl: empty tree");
+    }
+    doTraverseRnl(root(), f);
+    return f;
+  }
+
+  template < class Key, class T, class Compare, size_t Order >
+  template < class F >
+  F BTree< Key, T, Compare, Order >::traverse_rnl(F f)
+  {
+    return static_cast< const BTree & >(*this).traverse_rnl(f);
+  }
+
+  template < class Key, class T, class Compare, size_t Order >
+  template < class F >
+  F BTree< Key, T, Compare, Order >::traverse_breadth(F f) const
+  {
+    if (empty())
+    {
+      throw std::logic_error("travers_breadth: tree empty");
+    }
+    Queue< const Node * > nodeQueue;
+    nodeQueue.push(root());
+    while (!nodeQueue.empty())
+    {
+      const Node *currNode = nodeQueue.front();
+      nodeQueue.pop();
+      for (size_t i = 0; i < currNode->count; ++i)
+      {
+        f(currNode->pairs[i]);
+      }
+      if (!currNode->isLeaf)
+      {
+        auto inner = static_cast< const InnerNode * >(currNode);
+        for (size_t i = 0; i <= currNode->count; ++i)
+        {
+          nodeQueue.push(inner->children[i]);
+        }
+      }
+    }
+    return f;
+  }
+
+  template < class Key, class T, class Compare, size_t Order >
+  template < class F >
+  F BTree< Key, T, Compare, Order >::traverse_breadth(F f)
+  {
+    return static_cast< const BTree & >(*this).traverse_breadth(f);
+  }
+
+  template < class Key, class T, class Compare, size_t Order >
+  size_t BTree< Key, T, Compare, Order >::count(const Key &key) const
+  {
+    return doFind(key).second ? 1 : 0;
+  }
+
+  template < class Key, class T, class Compare, size_t Order >
+  std::pair< typename BTree< Key, T, Compare, Order >::iterator, typename BTree< Key, T, Compare, Order >::iterator >
+  BTree< Key, T, Compare, Order >::equal_range(const Key &key)
+  {
+    auto resultPair = doFind(key);
+    auto secondIt = resultPair.first;
+    if (resultPair.second)
+    {
+      secondIt++;
+    }
+    return std::make_pair(resultPair.first, secondIt);
+  }
+
+  template < class Key, class T, class Compare, size_t Order >
+  std::pair< typename BTree< Key, T, Compare, Order >::const_iterator,
+    typename BTree< Key, T, Compare, Order >::const_iterator >
+  BTree< Key, T, Compare, Order >::equal_range(const Key &key) const
+  {
+    auto resultPair = doFind(key);
+    const_iterator secondIt(resultPair.first);
+    if (resultPair.second)
+    {
+      secondIt++;
+    }
+    return std::make_pair(const_iterator(resultPair.first), secondIt);
+  }
+
+  template < class Key, class T, class Compare, size_t Order >
+  typename BTree< Key, T, Compare, Order >::Node *BTree< Key, T, Compare, Order >::head() const noexcept
+  {
+    return const_cast< InnerNode * >(&head_);
+  }
+
+  template < class Key, class T, class Compare, size_t Order >
+  typename BTree< Key, T, Compare, Order >::Node *BTree< Key, T, Compare, Order >::root() const noexcept
+  {
+    return head_.children[0];
+  }
+
+  template < class Key, class T, class Compare, size_t Order >
+  void BTree< Key, T, Compare, Order >::setRoot(Node *newRoot) noexcept
+  {
+    head_.children[0] = newRoot;
+    if (newRoot)
+    {
+      newRoot->parent = head();
+    }
+  }
+
+  template < class Key, class T, class Compare, size_t Order >
+  size_t BTree< Key, T, Compare, Order >::lowerIndex(const Node *node, const Key &key) const
+  {
+    size_t first = 0;
+    size_t last = node->count;
+    while (first < last)
+    {
+      size_t mid = first + (last - first) / 2;
+      if (compare_(node->pairs[mid].first, key))
+      {
+        first = mid + 1;
+      }
+      else
+      {
+        last = mid;
+      }
+    }
+    return first;
+  }
+
+  // Finds the key or, if it is absent, the first greater one
+  template < class Key, class T, class Compare, size_t Order >
+  std::pair< typename BTree< Key, T, Compare, Order >::iterator, bool >
+  BTree< Key, T, Compare, Order >::doFind(const Key &key) const
+  {
+    Node *currNode = root();
+    iterator bound(head(), 0);
+    while (currNode)
+    {
+      size_t index = lowerIndex(currNode, key);
+      if (index < currNode->count)
+      {
+        bound = iterator(currNode, index);
+        if (!compare_(key, currNode->pairs[index].first))
+        {
+          return std::make_pair(bound, true);
+        }
+      }
+      if (currNode->isLeaf)
+      {
+        break;
+      }
+      currNode = detail::toInner(currNode)->children[index];
+    }
+    return std::make_pair(bound, false);
+  }
+
+  template < class Key, class T, class Compare, size_t Order >
+  template < class P >
+  std::pair< typename BTree< Key, T, Compare, Order >::iterator, bool >
+  BTree< Key, T, Compare, Order >::doInsert(P &&newPair)
+  {
+    if (!root())
+    {
+      setRoot(createNode(true));
+    }
+    Node *currNode = root();
+    size_t index = 0;
+    while (true)
+    {
+      index = lowerIndex(currNode, newPair.first);
+      if (index < currNode->count && !compare_(newPair.first, currNode->pairs[index].first))
+      {
+        return std::make_pair(iterator(currNode, index), false);
+      }
+      if (currNode->isLeaf)
+      {
+        break;
+      }
+      currNode = detail::toInner(currNode)->children[index];
+    }
+    std::move_backward(currNode->pairs + index, currNode->pairs + currNode->count, currNode->pairs + currNode->count + 1);
+    currNode->pairs[index] = std::forward< P >(newPair);
+    currNode->count++;
+    size_++;
+    iterator result(currNode, index);
+    while (currNode->count > maxCount)
+    {
+      currNode = split(currNode, result);
+    }
+    return std::make_pair(result, true);
+  }
+
+  // Moves the upper half of an overflowed node into a new right sibling and
+  // the median into the parent; tracked is kept pointing at the same pair
+  template < class Key, class T, class Compare, size_t Order >
+  typename BTree< Key, T, Compare, Order >::Node *BTree< Key, T, Compare, Order >::split(Node *node, iterator &tracked)
+  {
+    if (node->parent == head())
+    {
+      Node *newRoot = createNode(false);
+      detail::toInner(newRoot)->children[0] = node;
+      setRoot(newRoot);
+      node->parent = newRoot;
+    }
+    InnerNode *parent = detail::toInner(node->parent);
+    Node *right = createNode(node->isLeaf);
+    size_t mid = node->count / 2;
+    std::move(node->pairs + mid + 1, node->pairs + node->count, right->pairs);
+    right->count = node->count - mid - 1;
+    right->parent = parent;
+    if (!node->isLeaf)
+    {
+      moveChildren(detail::toInner(node), mid + 1, node->count + 1, detail::toInner(right), 0);
+    }
+
+    size_t pos = detail::findChildPos< MapPair, Order >(parent, node);
+    std::move_backward(parent->pairs + pos, parent->pairs + parent->count, parent->pairs + parent->count + 1);
+    std::copy_backward(parent->children + pos + 1, parent->children + parent->count + 1,
+      parent->children + parent->count + 2);
+    parent->pairs[pos] = std::move(node->pairs[mid]);
+    parent->children[pos + 1] = right;
+    parent->count++;
+    node->count = mid;
+
+    if (tracked.node_ == node && tracked.index_ >= mid)
+    {
+      tracked = tracked.index_ == mid ? iterator(parent, pos) : iterator(right, tracked.index_ - mid - 1);
+    }
+    return parent;
+  }
+
+  template < class Key, class T, class Compare, size_t Order >
+  void BTree< Key, T, Compare, Order >::rebalance(Node *node)
+  {
+    while (node != root() && node->count < minCount)
+    {
+      InnerNode *parent = detail::toInner(node->parent);
+      size_t pos = detail::findChildPos< MapPair, Order >(parent, node);
+      if (pos > 0 && parent->children[pos - 1]->count > minCount)
+      {
+        rotateRight(parent, pos - 1);
+        return;
+      }
+      if (pos < parent->count && parent->children[pos + 1]->count > minCount)
+      {
+        rotateLeft(parent, pos);
+        return;
+      }
+      merge(parent, pos > 0 ? pos - 1 : pos);
+      node = parent;
+    }
+    Node *oldRoot = root();
+    if (oldRoot->count == 0)
+    {
+      setRoot(oldRoot->isLeaf ? nullptr : detail::toInner(oldRoot)->children[0]);
+      deleteNode(oldRoot);
+    }
+  }
+
+  template < class Key, class T, class Compare, size_t Order >
+  void BTree< Key, T, Compare, Order >::rotateLeft(InnerNode *parent, size_t sep)
+  {
+    Node *left = parent->children[sep];
+    Node *right = parent->children[sep + 1];
+    left->pairs[left->count] = std::move(parent->pairs[sep]);
+    parent->pairs[sep] = std::move(right->pairs[0]);
+    std::move(right->pairs + 1, right->pairs + right->count, right->pairs);
+    if (!left->isLeaf)
+    {
+      moveChildren(detail::toInner(right), 0, 1, detail::toInner(left), left->count + 1);
+      moveChildren(detail::toInner(right), 1, right->count + 1, detail::toInner(right), 0);
+    }
+    left->count++;
+    right->count--;
+  }
+
+  template < class Key, class T, class Compare, size_t Order >
+  void BTree< Key, T, Compare, Order >::rotateRight(InnerNode *parent, size_t sep)
+  {
+    Node *left = parent->children[sep];
+    Node *right = parent->children[sep + 1];
+    std::move_backward(right->pairs, right->pairs + right->count, right->pairs + right->count + 1);
+    right->pairs[0] = std::move(parent->pairs[sep]);
+    parent->pairs[sep] = std::move(left->pairs[left->count - 1]);
+    if (!right->isLeaf)
+    {
+      InnerNode *innerRight = detail::toInner(right);
+      std::copy_backward(innerRight->children, innerRight->children + right->count + 1,
+        innerRight->children + right->count + 2);
+      moveChildren(detail::toInner(left), left->count, left->count + 1, innerRight, 0);
+    }
+    left->count--;
+    right->count++;
+  }
+
+  template < class Key, class T, class Compare, size_t Order >
+  void BTree< Key, T, Compare, Order >::merge(InnerNode *parent, size_t sep)
+  {
+    Node *left = parent->children[sep];
+    Node *right = parent->children[sep + 1];
+    left->pairs[left->count] = std::move(parent->pairs[sep]);
+    std::move(right->pairs, right->pairs + right->count, left->pairs + left->count + 1);
+    if (!left->isLeaf)
+    {
+      moveChildren(detail::toInner(right), 0, right->count + 1, detail::toInner(left), left->count + 1);
+    }
+    left->count += right->count + 1;
+
+    std::move(parent->pairs + sep + 1, parent->pairs + parent->count, parent->pairs + sep);
+    std::copy(parent->children + sep + 2, parent->children + parent->count + 1, parent->children + sep + 1);
+    parent->count--;
+    deleteNode(right);
+  }
+
+  template < class Key, class T, class Compare, size_t Order >
+  template < class F >
+  void BTree< Key, T, Compare, Order >::doTraverseLnr(const Node *node, F &f)
+  {
+    auto inner = static_cast< const InnerNode * >(node);
+    for (size_t i = 0; i < node->count; ++i)
+    {
+      if (!node->isLeaf)
+      {
+        doTraverseLnr(inner->children[i], f);
+      }
+      f(node->pairs[i]);
+    }
+    if (!node->isLeaf)
+    {
+      doTraverseLnr(inner->children[node->count], f);
+    }
+  }
+
+  template < class Key, class T, class Compare, size_t Order >
+  template < class F >
+  void BTree< Key, T, Compare, Order >::doTraverseRnl(const Node *node, F &f)
+  {
+    auto inner = static_cast< const InnerNode * >(node);
+    for (size_t i = node->count; i > 0; --i)
+    {
+      if (!node->isLeaf)
+      {
+        doTraverseRnl(inner->children[i], f);
+      }
+      f(node->pairs[i - 1]);
+    }
+    if (!node->isLeaf)
+    {
+      doTraverseRnl(inner->children[0], f);
+    }
+  }
+
+  template < class Key, class T, class Compare, size_t Order >
+  typename BTree< Key, T, Compare, Order >::Node *BTree< Key, T, Compare, Order >::createNode(bool isLeaf)
+  {
+    Node *node = nullptr;
+    if (isLeaf)
+    {
+      node = new Node();
+    }
+    else
+    {
+      node = new InnerNode();
+    }
+    node->isLeaf = isLeaf;
+    return node;
+  }
+
+  template < class Key, class T, class Compare, size_t Order >
+  void BTree< Key, T, Compare, Order >::deleteNode(Node *node) noexcept
+  {
+    if (node->isLeaf)
+    {
+      delete node;
+    }
+    else
+    {
+      delete detail::toInner(node);
+    }
+  }
+
+  template < class Key, class T, class Compare, size_t Order >
+  void BTree< Key, T, Compare, Order >::deleteSubtree(Node *node) noexcept
+  {
+    if (!node)
+    {
+      return;
+    }
+    if (!node->isLeaf)
+    {
+      for (size_t i = 0; i <= node->count; ++i)
+      {
+        deleteSubtree(detail::toInner(node)->children[i]);
+      }
+    }
+    deleteNode(node);
+  }
+
+  template < class Key, class T, class Compare, size_t Order >
+  typename BTree< Key, T, Compare, Order >::Node *BTree< Key, T, Compare, Order >::copySubtree(
+    const Node *node, Node *parent)
+  {
+    Node *copy = createNode(node->isLeaf);
+    copy->parent = parent;
+    copy->count = node->count;
+    try
+    {
+      std::copy(node->pairs, node->pairs + node->count, copy->pairs);
+      if (!node->isLeaf)
+      {
+        auto from = static_cast< const InnerNode * >(node);
+        for (size_t i = 0; i <= node->count; ++i)
+        {
+          detail::toInner(copy)->children[i] = copySubtree(from->children[i], copy);
+        }
+      }
+    }
+    catch (...)
+    {
+      deleteSubtree(copy);
+      throw;
+    }
+    return copy;
+  }
+
+  template < class Key, class T, class Compare, size_t Order >
+  void BTree< Key, T, Compare, Order >::moveChildren(InnerNode *from, size_t first, size_t last,
+    InnerNode *to, size_t dest)
+  {
+    for (size_t i = first; i < last; ++i)
+    {
+      to->children[dest + i - first] = from->children[i];
+      to->children[dest + i - first]->parent = to;
+    }
+  }
+}
+
+#endif
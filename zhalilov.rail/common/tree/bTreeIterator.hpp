@@ -0,0 +1,107 @@
+#ifndef BTREEITERATOR_HPP
+#define BTREEITERATOR_HPP
+
+#include <iterator>
+
+#include "bTreeNode.hpp"
+
+namespace zhalilov
+{
+  template < class Key, class T, class Compare, size_t Order >
+  class BTree;
+
+  template < class T, size_t Order >
+  class ConstBTreeIterator;
+
+  template < class T, size_t Order >
+  class BTreeIterator: public std::iterator < std::bidirectional_iterator_tag, T >
+  {
+  public:
+    ~BTreeIterator() = default;
+
+    BTreeIterator &operator=(const BTreeIterator &) = default;
+
+    BTreeIterator &operator++();
+    BTreeIterator &operator--();
+    BTreeIterator operator++(int);
+    BTreeIterator operator--(int);
+
+    T &operator*() const;
+    T *operator->() const;
+
+    bool operator==(BTreeIterator) const;
+    bool operator!=(BTreeIterator) const;
+
+    template < class Key, class Value, class Compare, size_t N >
+    friend class BTree;
+    friend class ConstBTreeIterator< T, Order >;
+
+  private:
+    detail::BTreeNode < T, Order > *node_;
+    size_t index_;
+
+    BTreeIterator(detail::BTreeNode < T, Order > *node, size_t index);
+  };
+
+  template < class T, size_t Order >
+  BTreeIterator < T, Order > &BTreeIterator < T, Order >::operator++()
+  {
+    detail::stepForward(node_, index_);
+    return *this;
+  }
+
+  template < class T, size_t Order >
+  BTreeIterator < T, Order > &BTreeIterator < T, Order >::operator--()
+  {
+    detail::stepBackward(node_, index_);
+    return *this;
+  }
+
+  template < class T, size_t Order >
+  BTreeIterator < T, Order > BTreeIterator < T, Order >::operator++(int)
+  {
+    BTreeIterator temp(*this);
+    operator++();
+    return temp;
+  }
+
+  template < class T, size_t Order >
+  BTreeIterator < T, Order > BTreeIterator < T, Order >::operator--(int)
+  {
+    BTreeIterator temp(*this);
+    operator--();
+    return temp;
+  }
+
+  template < class T, size_t Order >
+  T &BTreeIterator < T, Order >::operator*() const
+  {
+    return node_->pairs[index_];
+  }
+
+  template < class T, size_t Order >
+  T *BTreeIterator < T, Order >::operator->() const
+  {
+    return &node_->pairs[index_];
+  }
+
+  template < class T, size_t Order >
+  bool BTreeIterator < T, Order >::operator==(BTreeIterator ait) const
+  {
+    return ait.node_ == node_ && ait.index_ == index_;
+  }
+
+  template < class T, size_t Order >
+  bool BTreeIterator < T, Order >::operator!=(BTreeIterator ait) const
+  {
+    return !operator==(ait);
+  }
+
+  template < class T, size_t Order >
+  BTreeIterator < T, Order >::BTreeIterator(detail::BTreeNode < T, Order > *node, size_t index):
+    node_(node),
+    index_(index)
+  {}
+}
+
+#endif
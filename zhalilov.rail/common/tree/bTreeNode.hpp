@@ -0,0 +1,115 @@
+#ifndef BTREENODE_HPP
+#define BTREENODE_HPP
+
+#include <cstddef>
+#include <utility>
+
+namespace zhalilov
+{
+  namespace detail
+  {
+    // Order is the maximum number of children; one spare slot in both arrays
+    // lets a node overflow by a single element right before it is split
+    template < class T, size_t Order >
+    struct BTreeNode
+    {
+      BTreeNode *parent;
+      size_t count;
+      bool isLeaf;
+      T pairs[Order];
+    };
+
+    template < class T, size_t Order >
+    struct BTreeInnerNode: BTreeNode< T, Order >
+    {
+      BTreeNode< T, Order > *children[Order + 1];
+    };
+
+    template < class T, size_t Order >
+    BTreeInnerNode< T, Order > *toInner(BTreeNode< T, Order > *node)
+    {
+      return static_cast< BTreeInnerNode< T, Order > * >(node);
+    }
+
+    template < class T, size_t Order >
+    size_t findChildPos(const BTreeNode< T, Order > *parent, const BTreeNode< T, Order > *child)
+    {
+      auto inner = static_cast< const BTreeInnerNode< T, Order > * >(parent);
+      size_t pos = 0;
+      while (inner->children[pos] != child)
+      {
+        pos++;
+      }
+      return pos;
+    }
+
+    template < class T, size_t Order >
+    BTreeNode< T, Order > *findDeepestLeft(BTreeNode< T, Order > *node)
+    {
+      while (!node->isLeaf && toInner(node)->children[0])
+      {
+        node = toInner(node)->children[0];
+      }
+      return node;
+    }
+
+    template < class T, size_t Order >
+    BTreeNode< T, Order > *findDeepestRight(BTreeNode< T, Order > *node)
+    {
+      while (!node->isLeaf && toInner(node)->children[node->count])
+      {
+        node = toInner(node)->children[node->count];
+      }
+      return node;
+    }
+
+    template < class T, size_t Order >
+    void stepForward(BTreeNode< T, Order > *&node, size_t &index)
+    {
+      if (!node->isLeaf)
+      {
+        node = findDeepestLeft(toInner(node)->children[index + 1]);
+        index = 0;
+        return;
+      }
+      index++;
+      while (index == node->count && node->parent)
+      {
+        index = findChildPos(node->parent, node);
+        node = node->parent;
+      }
+    }
+
+    template < class T, size_t Order >
+    void stepBackward(BTreeNode< T, Order > *&node, size_t &index)
+    {
+      if (!node->isLeaf)
+      {
+        BTreeNode< T, Order > *child = toInner(node)->children[index];
+        if (!child)
+        {
+          // end() of an empty tree: the head has no root below it
+          return;
+        }
+        node = findDeepestRight(child);
+        index = node->count - 1;
+        return;
+      }
+      while (index == 0 && node->parent)
+      {
+        index = findChildPos(node->parent, node);
+        node = node->parent;
+      }
+      index--;
+    }
+
+    template < class Key, class T >
+    constexpr size_t defaultBTreeOrder()
+    {
+      // eight cache lines of pairs per node, but never less than a 2-3-4 tree
+      return 512 / sizeof(std::pair< Key, T >) > 4 ? 512 / sizeof(std::pair< Key, T >) : 4;
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,111 @@
+#ifndef CONST_BTREEITERATOR_HPP
+#define CONST_BTREEITERATOR_HPP
+
+#include <iterator>
+
+#include "bTreeIterator.hpp"
+#include "bTreeNode.hpp"
+
+namespace zhalilov
+{
+  template < class Key, class T, class Compare, size_t Order >
+  class BTree;
+
+  template < class T, size_t Order >
+  class ConstBTreeIterator: public std::iterator < std::bidirectional_iterator_tag, const T >
+  {
+  public:
+    ConstBTreeIterator(BTreeIterator< T, Order >);
+    ~ConstBTreeIterator() = default;
+
+    ConstBTreeIterator &operator=(const ConstBTreeIterator &) = default;
+
+    ConstBTreeIterator &operator++();
+    ConstBTreeIterator &operator--();
+    ConstBTreeIterator operator++(int);
+    ConstBTreeIterator operator--(int);
+
+    const T &operator*() const;
+    const T *operator->() const;
+
+    bool operator==(ConstBTreeIterator) const;
+    bool operator!=(ConstBTreeIterator) const;
+
+    template < class Key, class Value, class Compare, size_t N >
+    friend class BTree;
+
+  private:
+    detail::BTreeNode < T, Order > *node_;
+    size_t index_;
+
+    ConstBTreeIterator(detail::BTreeNode < T, Order > *node, size_t index);
+  };
+
+  template < class T, size_t Order >
+  ConstBTreeIterator < T, Order >::ConstBTreeIterator(BTreeIterator< T, Order > it):
+    node_(it.node_),
+    index_(it.index_)
+  {}
+
+  template < class T, size_t Order >
+  ConstBTreeIterator < T, Order > &ConstBTreeIterator < T, Order >::operator++()
+  {
+    detail::stepForward(node_, index_);
+    return *this;
+  }
+
+  template < class T, size_t Order >
+  ConstBTreeIterator < T, Order > &ConstBTreeIterator < T, Order >::operator--()
+  {
+    detail::stepBackward(node_, index_);
+    return *this;
+  }
+
+  template < class T, size_t Order >
+  ConstBTreeIterator < T, Order > ConstBTreeIterator < T, Order >::operator++(int)
+  {
+    ConstBTreeIterator temp(*this);
+    operator++();
+    return temp;
+  }
+
+  template < class T, size_t Order >
+  ConstBTreeIterator < T, Order > ConstBTreeIterator < T, Order >::operator--(int)
+  {
+    ConstBTreeIterator temp(*this);
+    operator--();
+    return temp;
+  }
+
+  template < class T, size_t Order >
+  const T &ConstBTreeIterator < T, Order >::operator*() const
+  {
+    return node_->pairs[index_];
+  }
+
+  template < class T, size_t Order >
+  const T *ConstBTreeIterator < T, Order >::operator->() const
+  {
+    return &node_->pairs[index_];
+  }
+
+  template < class T, size_t Order >
+  bool ConstBTreeIterator < T, Order >::operator==(ConstBTreeIterator ait) const
+  {
+    return ait.node_ == node_ && ait.index_ == index_;
+  }
+
+  template < class T, size_t Order >
+  bool ConstBTreeIterator < T, Order >::operator!=(ConstBTreeIterator ait) const
+  {
+    return !operator==(ait);
+  }
+
+  template < class T, size_t Order >
+  ConstBTreeIterator < T, Order >::ConstBTreeIterator(detail::BTreeNode < T, Order > *node, size_t index):
+    node_(node),
+    index_(index)
+  {}
+}
+
+#endif
@@ -75,6 +75,8 @@ namespace zhalilov
           prevNode = node_;
           node_ = node_->parent;
         }
+        isPtrToLeft_ = node_->type != detail::NodeType::Three || node_->mid != prevNode;
+        return *this;
       }
     }
     else
@@ -93,11 +95,14 @@ namespace zhalilov
       if (!isPtrToLeft_)
       {
         detail::TreeNode < T > *maxMid = findDeepestRight(node_->mid);
-        if (maxMid == node_)
+        if (maxMid)
+        {
+          node_ = maxMid;
+        }
+        else
         {
           isPtrToLeft_ = true;
         }
-        node_ = maxMid;
         return *this;
       }
     }
@@ -113,7 +118,10 @@ namespace zhalilov
         }
         if (node_->parent)
         {
+          detail::TreeNode < T > *prevNode = node_;
           node_ = node_->parent;
+          isPtrToLeft_ = node_->type == detail::NodeType::Three && node_->mid == prevNode;
+          return *this;
         }
       }
     }
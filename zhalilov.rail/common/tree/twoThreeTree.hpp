@@ -64,10 +64,22 @@ namespace zhalilov
     F traverse_breadth(F f) const;
     template < class F >
     F traverse_breadth(F f);
+    template < class F >
+    F traverse_lnr(const Key &lo, const Key &hi, F f) const;
+    template < class F >
+    F traverse_lnr(const Key &lo, const Key &hi, F f);
+    template < class F >
+    F traverse_rnl(const Key &lo, const Key &hi, F f) const;
+    template < class F >
+    F traverse_rnl(const Key &lo, const Key &hi, F f);
 
     size_t count(const Key &) const;
     std::pair< iterator, iterator > equal_range(const Key &);
     std::pair< const_iterator, const_iterator > equal_range(const Key &) const;
+    iterator lower_bound(const Key &);
+    const_iterator lower_bound(const Key &) const;
+    iterator upper_bound(const Key &);
+    const_iterator upper_bound(const Key &) const;
 
   private:
     Compare compare_;
@@ -76,6 +88,7 @@ namespace zhalilov
     size_t size_;
 
     std::pair< iterator, bool > doFind(const Key &) const;
+    iterator doBound(const Key &, bool isUpper) const;
     Node *createTwoNode(const MapPair &) const;
     Node *createThreeNode(const MapPair &, const MapPair &) const;
     void connectNodes(Node *parent, Node *left, Node *right, Node *mid = nullptr);
@@ -145,6 +158,7 @@ namespace zhalilov
     if (head_ != other.head_)
     {
       clear();
+      delete head_;
       head_ = other.head_;
       size_ = other.size_;
       other.head_ = nullptr;
@@ -416,9 +430,9 @@ namespace zhalilov
     auto resultPair = doFind(key);
     if (resultPair.second)
     {
-      return std::make_pair(const_iterator(resultPair.first.node_, resultPair.first.isPtrToLeft_), true);
+      return const_iterator(resultPair.first.node_, resultPair.first.isPtrToLeft_);
     }
-    return std::make_pair(cend(), false);
+    return cend();
   }
 
   template < class Key, class T, class Compare >
@@ -443,8 +457,7 @@ namespace zhalilov
   template < class F >
   F TwoThree< Key, T, Compare >::traverse_lnr(F f)
   {
-    const TwoThree< Key, T, Compare > constThis = const_cast< TwoThree< Key, T, Compare > & >(*this);
-    return constThis.traverse_lnr(f);
+    return static_cast< const TwoThree< Key, T, Compare > & >(*this).traverse_lnr(f);
   }
 
   template < class Key, class T, class Compare >
@@ -472,8 +485,61 @@ namespace zhalilov
   template < class F >
   F TwoThree< Key, T, Compare >::traverse_rnl(F f)
   {
-    const TwoThree< Key, T, Compare > constThis = const_cast< TwoThree< Key, T, Compare > & >(*this);
-    return constThis.traverse_rnl(f);
+    return static_cast< const TwoThree< Key, T, Compare > & >(*this).traverse_rnl(f);
+  }
+
+  template < class Key, class T, class Compare >
+  template < class F >
+  F TwoThree< Key, T, Compare >::traverse_lnr(const Key &lo, const Key &hi, F f) const
+  {
+    if (empty())
+    {
+      throw std::logic_error("travers_lnr: empty tree");
+    }
+    auto itCurr = lower_bound(lo);
+    auto itEnd = cend();
+    while (itCurr != itEnd && !compare_(hi, itCurr->first))
+    {
+      f(*itCurr);
+      itCurr++;
+    }
+    return f;
+  }
+
+  template < class Key, class T, class Compare >
+  template < class F >
+  F TwoThree< Key, T, Compare >::traverse_lnr(const Key &lo, const Key &hi, F f)
+  {
+    return static_cast< const TwoThree< Key, T, Compare > & >(*this).traverse_lnr(lo, hi, f);
+  }
+
+  template < class Key, class T, class Compare >
+  template < class F >
+  F TwoThree< Key, T, Compare >::traverse_rnl(const Key &lo, const Key &hi, F f) const
+  {
+    if (empty())
+    {
+      throw std::logic_error("travers_rnl: empty tree");
+    }
+    auto itCurr = upper_bound(hi);
+    auto itBegin = cbegin();
+    while (itCurr != itBegin)
+    {
+      itCurr--;
+      if (compare_(itCurr->first, lo))
+      {
+        break;
+      }
+      f(*itCurr);
+    }
+    return f;
+  }
+
+  template < class Key, class T, class Compare >
+  template < class F >
+  F TwoThree< Key, T, Compare >::traverse_rnl(const Key &lo, const Key &hi, F f)
+  {
+    return static_cast< const TwoThree< Key, T, Compare > & >(*this).traverse_rnl(lo, hi, f);
   }
 
   template < class Key, class T, class Compare >
@@ -567,6 +633,71 @@ namespace zhalilov
     return std::make_pair(firstIt, secondIt);
   }
 
+  template < class Key, class T, class Compare >
+  typename TwoThree< Key, T, Compare >::iterator TwoThree< Key, T, Compare >::lower_bound(const Key &key)
+  {
+    return doBound(key, false);
+  }
+
+  template < class Key, class T, class Compare >
+  typename TwoThree< Key, T, Compare >::const_iterator TwoThree< Key, T, Compare >::lower_bound(
+    const Key &key) const
+  {
+    auto nonConstIt = doBound(key, false);
+    return const_iterator(nonConstIt.node_, nonConstIt.isPtrToLeft_);
+  }
+
+  template < class Key, class T, class Compare >
+  typename TwoThree< Key, T, Compare >::iterator TwoThree< Key, T, Compare >::upper_bound(const Key &key)
+  {
+    return doBound(key, true);
+  }
+
+  template < class Key, class T, class Compare >
+  typename TwoThree< Key, T, Compare >::const_iterator TwoThree< Key, T, Compare >::upper_bound(
+    const Key &key) const
+  {
+    auto nonConstIt = doBound(key, true);
+    return const_iterator(nonConstIt.node_, nonConstIt.isPtrToLeft_);
+  }
+
+  // One descent from the root: every key that passes the bound is a better
+  // candidate than the last one, and only the subtree left of it can hold
+  // a better one still.
+  template < class Key, class T, class Compare >
+  typename TwoThree< Key, T, Compare >::iterator TwoThree< Key, T, Compare >::doBound(const Key &key,
+    bool isUpper) const
+  {
+    iterator result(head_, true);
+    if (empty())
+    {
+      return result;
+    }
+    auto isPassing = [this, &key, isUpper](const Key &nodeKey)
+    {
+      return isUpper ? compare_(key, nodeKey) : !compare_(nodeKey, key);
+    };
+    Node *currNode = head_->left;
+    while (currNode)
+    {
+      if (isPassing(currNode->one.first))
+      {
+        result = iterator(currNode, true);
+        currNode = currNode->left;
+      }
+      else if (currNode->type == detail::NodeType::Three && isPassing(currNode->two.first))
+      {
+        result = iterator(currNode, false);
+        currNode = currNode->mid;
+      }
+      else
+      {
+        currNode = currNode->right;
+      }
+    }
+    return result;
+  }
+
   template < class Key, class T, class Compare >
   std::pair< typename TwoThree< Key, T, Compare >::iterator, bool > TwoThree< Key, T, Compare >::doFind(const Key &key) const
   {